@@ -0,0 +1,459 @@
+// benchmark.h
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.h"
+
+/**
+ * Результат одного замера: время на операцию в наносекундах для каждого повторения,
+ * медиана и 95% доверительный интервал медианы, аппаратные счетчики за все повторения
+ */
+struct BenchmarkResult {
+    std::string name;
+    std::vector<double> samples;
+    double median = 0.0;
+    double low = 0.0;
+    double high = 0.0;
+    // Суммы счетчиков по повторениям и число операций в них; без perf_event_open счетчики недоступны
+    PerfCounters::Result counters;
+    size_t countedOperations = 0;
+};
+
+/**
+ * Сравнение замера с базовым уровнем
+ */
+struct BenchmarkComparison {
+    enum class Status { Unchanged, Regression, Improvement, New };
+
+    std::string name;
+    double baselineMedian = 0.0;
+    double currentMedian = 0.0;
+    Status status = Status::New;
+
+    /**
+     * Отношение медиан текущего замера и базового уровня
+     */
+    [[nodiscard]] double ratio() const {
+        return baselineMedian > 0.0 ? currentMedian / baselineMedian : 1.0;
+    }
+};
+
+/**
+ * Статистика повторений и сравнение с базовым уровнем
+ */
+class BenchmarkStatistics {
+public:
+    /**
+     * Медиана и доверительный интервал медианы без предположений о распределении:
+     * границы - порядковые статистики с рангами n/2 -+ 1.96 * sqrt(n) / 2
+     *
+     * @throws std::invalid_argument если повторений нет
+     */
+    static void summarize(BenchmarkResult& result) {
+        if (result.samples.empty()) {
+            throw std::invalid_argument("Нет повторений для замера " + result.name);
+        }
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        size_t n = sorted.size();
+        result.median = n % 2 == 1 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+
+        double spread = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+        double lowRank = std::floor(static_cast<double>(n) / 2.0 - spread);
+        double highRank = std::ceil(static_cast<double>(n) / 2.0 + spread);
+        size_t lowIndex = lowRank < 1.0 ? 0 : static_cast<size_t>(lowRank) - 1;
+        size_t highIndex = std::min(n, static_cast<size_t>(std::max(highRank, 1.0))) - 1;
+        result.low = sorted[lowIndex];
+        result.high = sorted[highIndex];
+    }
+
+    /**
+     * Сравнение с базовым уровнем. Замедление или ускорение засчитывается,
+     * только если медиана изменилась больше чем на threshold и доверительные
+     * интервалы не пересекаются, иначе разница считается шумом
+     *
+     * @param threshold Допустимое относительное изменение медианы (0.1 = 10%)
+     */
+    static std::vector<BenchmarkComparison> compare(const std::vector<BenchmarkResult>& baseline,
+                                                    const std::vector<BenchmarkResult>& current,
+                                                    double threshold) {
+        std::vector<BenchmarkComparison> comparisons;
+        for (const auto& result : current) {
+            BenchmarkComparison comparison;
+            comparison.name = result.name;
+            comparison.currentMedian = result.median;
+
+            auto previous = std::find_if(baseline.begin(), baseline.end(), [&result](const BenchmarkResult& candidate) {
+                return candidate.name == result.name;
+            });
+            if (previous != baseline.end()) {
+                comparison.baselineMedian = previous->median;
+                comparison.status = BenchmarkComparison::Status::Unchanged;
+                if (result.median > previous->median * (1.0 + threshold) && result.low > previous->high) {
+                    comparison.status = BenchmarkComparison::Status::Regression;
+                } else if (result.median * (1.0 + threshold) < previous->median && result.high < previous->low) {
+                    comparison.status = BenchmarkComparison::Status::Improvement;
+                }
+            }
+            comparisons.push_back(comparison);
+        }
+        return comparisons;
+    }
+
+    [[nodiscard]] static bool hasRegression(const std::vector<BenchmarkComparison>& comparisons) {
+        return std::any_of(comparisons.begin(), comparisons.end(), [](const BenchmarkComparison& comparison) {
+            return comparison.status == BenchmarkComparison::Status::Regression;
+        });
+    }
+};
+
+/**
+ * Чтение и запись результатов в JSON вида
+ * {"benchmarks": [{"name": "...", "median": 1.5, "low": 1.4, "high": 1.7, "samples": [...],
+ *                  "counters": {"ipc": 2.1, "llc_misses": 0.02, ...}}]}
+ * Поле counters (IPC и счетчики на операцию) пишется, только если счетчики доступны,
+ * и при чтении пропускается: сравнение с базовым уровнем идет по времени
+ */
+class BenchmarkJson {
+private:
+    const std::string& text_;
+    size_t position_;
+
+    explicit BenchmarkJson(const std::string& text) : text_(text), position_(0) {}
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("Ошибка разбора JSON (позиция " + std::to_string(position_) + "): " + message);
+    }
+
+    void skipSpaces() {
+        while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_]))) {
+            ++position_;
+        }
+    }
+
+    bool consume(char expected) {
+        skipSpaces();
+        if (position_ < text_.size() && text_[position_] == expected) {
+            ++position_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char expected) {
+        if (!consume(expected)) {
+            fail(std::string("ожидался символ '") + expected + "'");
+        }
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string result;
+        while (position_ < text_.size() && text_[position_] != '"') {
+            char symbol = text_[position_++];
+            if (symbol == '\\') {
+                if (position_ >= text_.size()) {
+                    break;
+                }
+                symbol = text_[position_++];
+                if (symbol == 'n') {
+                    symbol = '\n';
+                } else if (symbol == 't') {
+                    symbol = '\t';
+                }
+            }
+            result += symbol;
+        }
+        expect('"');
+        return result;
+    }
+
+    double parseNumber() {
+        skipSpaces();
+        const char* begin = text_.c_str() + position_;
+        char* end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin) {
+            fail("ожидалось число");
+        }
+        position_ += static_cast<size_t>(end - begin);
+        return value;
+    }
+
+    /**
+     * Разбор перечисления item(), разделенного запятыми, до закрывающего символа
+     */
+    template <typename Item>
+    void parseList(char close, Item item) {
+        if (consume(close)) {
+            return;
+        }
+        do {
+            item();
+        } while (consume(','));
+        expect(close);
+    }
+
+    /**
+     * Пропуск значения неизвестного поля
+     */
+    void skipValue() {
+        skipSpaces();
+        if (position_ >= text_.size()) {
+            fail("неожиданный конец");
+        }
+        char symbol = text_[position_];
+        if (symbol == '"') {
+            (void)parseString();
+        } else if (consume('[')) {
+            parseList(']', [this] { skipValue(); });
+        } else if (consume('{')) {
+            parseList('}', [this] {
+                (void)parseString();
+                expect(':');
+                skipValue();
+            });
+        } else if (text_.compare(position_, 4, "true") == 0 || text_.compare(position_, 4, "null") == 0) {
+            position_ += 4;
+        } else if (text_.compare(position_, 5, "false") == 0) {
+            position_ += 5;
+        } else {
+            (void)parseNumber();
+        }
+    }
+
+    BenchmarkResult parseResult() {
+        BenchmarkResult result;
+        expect('{');
+        parseList('}', [this, &result] {
+            std::string key = parseString();
+            expect(':');
+            if (key == "name") {
+                result.name = parseString();
+            } else if (key == "median") {
+                result.median = parseNumber();
+            } else if (key == "low") {
+                result.low = parseNumber();
+            } else if (key == "high") {
+                result.high = parseNumber();
+            } else if (key == "samples") {
+                expect('[');
+                parseList(']', [this, &result] { result.samples.push_back(parseNumber()); });
+            } else {
+                skipValue();
+            }
+        });
+        return result;
+    }
+
+    std::vector<BenchmarkResult> parseDocument() {
+        std::vector<BenchmarkResult> results;
+        expect('{');
+        parseList('}', [this, &results] {
+            std::string key = parseString();
+            expect(':');
+            if (key == "benchmarks") {
+                expect('[');
+                parseList(']', [this, &results] { results.push_back(parseResult()); });
+            } else {
+                skipValue();
+            }
+        });
+        skipSpaces();
+        if (position_ != text_.size()) {
+            fail("лишние данные после документа");
+        }
+        return results;
+    }
+
+    static void writeString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char symbol : text) {
+            if (symbol == '"' || symbol == '\\') {
+                out << '\\';
+            }
+            out << symbol;
+        }
+        out << '"';
+    }
+
+    static void writeCounters(std::ostream& out, const BenchmarkResult& result) {
+        out << ", \"counters\": {";
+        bool first = true;
+        if (result.counters.has(PerfCounters::kCycles) && result.counters.has(PerfCounters::kInstructions)) {
+            out << "\"ipc\": " << result.counters.ipc();
+            first = false;
+        }
+        for (int i = 0; i < PerfCounters::kCounterCount; ++i) {
+            auto counter = static_cast<PerfCounters::Counter>(i);
+            if (result.counters.has(counter)) {
+                out << (first ? "" : ", ") << "\"" << PerfCounters::key(counter)
+                    << "\": " << result.counters.perElement(counter, result.countedOperations);
+                first = false;
+            }
+        }
+        out << "}";
+    }
+
+public:
+    /**
+     * @throws std::runtime_error если текст не соответствует формату
+     */
+    static std::vector<BenchmarkResult> parse(const std::string& text) {
+        return BenchmarkJson(text).parseDocument();
+    }
+
+    static void write(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::setprecision(17);
+
+        out << "{\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+            writeString(out, result.name);
+            out << ", \"median\": " << result.median << ", \"low\": " << result.low
+                << ", \"high\": " << result.high << ", \"samples\": [";
+            for (size_t j = 0; j < result.samples.size(); ++j) {
+                out << (j == 0 ? "" : ", ") << result.samples[j];
+            }
+            out << "]";
+            if (result.counters.any()) {
+                writeCounters(out, result);
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    /**
+     * @throws std::runtime_error если файл не удалось открыть или разобрать
+     */
+    static std::vector<BenchmarkResult> load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Не удалось открыть файл базового уровня: " + path);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return parse(buffer.str());
+    }
+
+    /**
+     * @throws std::runtime_error если файл не удалось открыть
+     */
+    static void save(const std::string& path, const std::vector<BenchmarkResult>& results) {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Не удалось открыть файл для записи: " + path);
+        }
+        write(file, results);
+    }
+};
+
+/**
+ * Набор замеров. Каждый замер выполняется один раз для прогрева,
+ * затем repetitions раз; время повторения делится на число операций.
+ * Вокруг каждого повторения снимаются аппаратные счетчики (PerfCounters),
+ * если они доступны
+ */
+class BenchmarkSuite {
+private:
+    struct Case {
+        std::string name;
+        size_t operations;
+        std::function<void()> body;
+        std::function<void()> setup;
+    };
+
+    std::vector<Case> cases_;
+
+public:
+    /**
+     * @param name Имя замера, по нему результаты сопоставляются с базовым уровнем
+     * @param operations Число операций за один вызов body
+     * @param body Замеряемый код
+     * @param setup Подготовка входных данных перед каждым вызовом body (и прогревочным тоже);
+     *              в замер времени и счетчиков не входит. Нужна, если body меняет свой вход
+     * @throws std::invalid_argument если operations равно 0
+     */
+    void add(const std::string& name, size_t operations, std::function<void()> body,
+             std::function<void()> setup = nullptr) {
+        if (operations == 0) {
+            throw std::invalid_argument("Число операций замера должно быть больше 0");
+        }
+        cases_.push_back(Case{name, operations, std::move(body), std::move(setup)});
+    }
+
+    [[nodiscard]] size_t size() const {
+        return cases_.size();
+    }
+
+    /**
+     * Выполнение замеров, имя которых содержит filter
+     *
+     * @throws std::invalid_argument если repetitions равно 0
+     */
+    std::vector<BenchmarkResult> run(size_t repetitions, const std::string& filter = "") {
+        if (repetitions == 0) {
+            throw std::invalid_argument("Число повторений должно быть больше 0");
+        }
+        std::vector<BenchmarkResult> results;
+        PerfCounters counters;
+        for (auto& benchmark : cases_) {
+            if (benchmark.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            BenchmarkResult result;
+            result.name = benchmark.name;
+            if (benchmark.setup) {
+                benchmark.setup();
+            }
+            benchmark.body();
+            for (size_t i = 0; i < repetitions; ++i) {
+                if (benchmark.setup) {
+                    benchmark.setup();
+                }
+                counters.start();
+                auto start = std::chrono::steady_clock::now();
+                benchmark.body();
+                auto end = std::chrono::steady_clock::now();
+                result.counters.accumulate(counters.stop(), i == 0);
+                double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+                result.samples.push_back(nanoseconds / static_cast<double>(benchmark.operations));
+            }
+            result.countedOperations = repetitions * benchmark.operations;
+            BenchmarkStatistics::summarize(result);
+            results.push_back(std::move(result));
+        }
+        return results;
+    }
+};
+
+/**
+ * Запрет компилятору выбрасывать вычисление value как неиспользуемое
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
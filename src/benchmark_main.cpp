@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "fibonacci.h"
+#include "palindrome.h"
+#include "linked_list.h"
+#include "list_view.h"
+
+// Замеры для чисел Фибоначчи
+void addFibonacciBenchmarks(BenchmarkSuite& suite) {
+    suite.add("fibonacci/generate94", 10000, [] {
+        for (int i = 0; i < 10000; ++i) {
+            auto sequence = FibonacciGenerator::generateFibonacci(94);
+            doNotOptimize(sequence);
+        }
+    });
+
+    suite.add("fibonacci/generateWrapping", 1000000, [] {
+        auto sequence = FibonacciGenerator::generateFibonacci<uint64_t, WrappingArithmetic>(1000000);
+        doNotOptimize(sequence);
+    });
+
+    suite.add("fibonacci/big100000", 1, [] {
+        auto value = FibonacciGenerator::fibonacciBig(100000);
+        doNotOptimize(value);
+    });
+
+    auto values = std::make_shared<std::vector<uint64_t>>(1 << 20);
+    auto flags = std::make_shared<std::vector<uint8_t>>(values->size());
+    std::mt19937_64 random(42);
+    for (auto& value : *values) {
+        value = random() >> (random() % 64);
+    }
+    suite.add("fibonacci/isFibonacciBatch", values->size(), [values, flags] {
+        FibonacciGenerator::isFibonacciBatch(values->data(), values->size(), flags->data());
+        doNotOptimize(*flags);
+    });
+}
+
+// Замеры для палиндромов
+void addPalindromeBenchmarks(BenchmarkSuite& suite) {
+    auto numbers = std::make_shared<std::vector<long long>>(1 << 18);
+    std::mt19937_64 random(7);
+    for (auto& number : *numbers) {
+        // Числа до 10^12, чтобы числовой метод не переполнялся при развороте
+        number = static_cast<long long>(random() % 1000000000000ULL);
+    }
+
+    suite.add("palindrome/string", numbers->size(), [numbers] {
+        size_t count = 0;
+        for (long long number : *numbers) {
+            count += PalindromeChecker::isPalindrome(number);
+        }
+        doNotOptimize(count);
+    });
+
+    suite.add("palindrome/numeric", numbers->size(), [numbers] {
+        size_t count = 0;
+        for (long long number : *numbers) {
+            count += PalindromeChecker::isPalindromeNumeric(number);
+        }
+        doNotOptimize(count);
+    });
+
+    suite.add("palindrome/digitTable", numbers->size(), [numbers] {
+        size_t count = 0;
+        for (long long number : *numbers) {
+            count += PalindromeChecker::isPalindromeDigitTable(number);
+        }
+        doNotOptimize(count);
+    });
+
+    auto results = std::make_shared<std::vector<long long>>(numbers->size());
+    suite.add("palindrome/nextPalindromeBatch", numbers->size(), [numbers, results] {
+        PalindromeChecker::nextPalindromeBatch(numbers->data(), numbers->size(), results->data());
+        doNotOptimize(*results);
+    });
+}
+
+// Замеры для связного списка
+void addLinkedListBenchmarks(BenchmarkSuite& suite) {
+    const size_t SIZE = 1 << 18;
+
+    suite.add("linked_list/pushFront", SIZE, [SIZE] {
+        LinkedList<int> list;
+        for (size_t i = 0; i < SIZE; ++i) {
+            list.pushFront(static_cast<int>(i));
+        }
+        doNotOptimize(list);
+    });
+
+    auto source = std::make_shared<std::vector<int>>(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        (*source)[i] = static_cast<int>(i);
+    }
+    suite.add("linked_list/fromVector", SIZE, [source] {
+        LinkedList<int> list(*source);
+        doNotOptimize(list);
+    });
+
+    // Одна и та же цепочка filter + map: через вектор и ленивым представлением за один проход
+    auto numbers = std::make_shared<LinkedList<int>>(*source);
+    suite.add("linked_list/roundTrip", SIZE, [numbers] {
+        std::vector<int> values = numbers->toVector();
+        std::vector<int> selected;
+        std::copy_if(values.begin(), values.end(), std::back_inserter(selected), [](int x) { return x % 2 == 0; });
+        std::transform(selected.begin(), selected.end(), selected.begin(), [](int x) { return x * 3; });
+        LinkedList<int> result(selected);
+        doNotOptimize(result);
+    });
+
+    suite.add("linked_list/viewPipeline", SIZE, [numbers] {
+        LinkedList<int> result = ListViews::from(*numbers)
+                                     .filter([](int x) { return x % 2 == 0; })
+                                     .map([](int x) { return x * 3; })
+                                     .collect();
+        doNotOptimize(result);
+    });
+
+    // Общий список для замеров, которые не меняют его размер
+    auto list = std::make_shared<LinkedList<int>>();
+    std::mt19937 random(3);
+    for (size_t i = 0; i < SIZE; ++i) {
+        list->pushFront(static_cast<int>(random()));
+    }
+
+    suite.add("linked_list/reverse", SIZE, [list] {
+        list->reverse();
+        doNotOptimize(*list);
+    });
+
+    suite.add("linked_list/traverse", SIZE, [list] {
+        long long sum = 0;
+        for (const auto* node = list->getHead().get(); node; node = node->next.get()) {
+            sum += node->data;
+        }
+        doNotOptimize(sum);
+    });
+
+    suite.add("linked_list/toVector", SIZE, [list] {
+        auto values = list->toVector();
+        doNotOptimize(values);
+    });
+
+    // Каждое повторение сортирует заново построенный список в одном и том же случайном порядке
+    auto unsortedValues = std::make_shared<std::vector<int>>(list->toVector());
+    auto unsorted = std::make_shared<LinkedList<int>>();
+    suite.add("linked_list/sort", SIZE, [unsorted] {
+        unsorted->sort();
+        doNotOptimize(*unsorted);
+    }, [unsorted, unsortedValues] {
+        unsorted->clear();
+        *unsorted = LinkedList<int>(*unsortedValues);
+    });
+
+    // Сортировка 10^7 элементов: через вектор (toVector, std::sort, новый список) и перестановкой узлов.
+    // Оба замера перед каждым повторением получают один и тот же заново построенный список в случайном
+    // порядке; построение и освобождение результата в замер не входят. Данные создаются при первой
+    // подготовке, чтобы другие замеры не платили за их память
+    const size_t LARGE = 10000000;
+    auto largeValues = std::make_shared<std::vector<int>>();
+    auto large = std::make_shared<LinkedList<int>>();
+    auto roundTripResult = std::make_shared<LinkedList<int>>();
+    auto rebuildLarge = [largeValues, large, roundTripResult, LARGE] {
+        if (largeValues->empty()) {
+            std::mt19937 largeRandom(11);
+            largeValues->resize(LARGE);
+            for (auto& value : *largeValues) {
+                value = static_cast<int>(largeRandom());
+            }
+        }
+        roundTripResult->clear();
+        large->clear();
+        *large = LinkedList<int>(*largeValues);
+    };
+
+    suite.add("linked_list/sortLargeRoundTrip", LARGE, [large, roundTripResult] {
+        std::vector<int> values = large->toVector();
+        std::sort(values.begin(), values.end());
+        *roundTripResult = LinkedList<int>(values);
+        doNotOptimize(*roundTripResult);
+    }, rebuildLarge);
+
+    suite.add("linked_list/sortLarge", LARGE, [large] {
+        large->sort();
+        doNotOptimize(*large);
+    }, rebuildLarge);
+
+    // Отдельный список с позиционным индексом; после сортировки узлы лежат в памяти вразброс
+    auto indexed = std::make_shared<LinkedList<int>>();
+    for (size_t i = 0; i < SIZE; ++i) {
+        indexed->pushFront(static_cast<int>(random()));
+    }
+    indexed->sort();
+    indexed->enableIndex();
+
+    suite.add("linked_list/indexedAt", 10000, [indexed, SIZE] {
+        long long sum = 0;
+        for (size_t i = 0; i < 10000; ++i) {
+            sum += indexed->at(i * 7919 % SIZE);
+        }
+        doNotOptimize(sum);
+    });
+
+    suite.add("linked_list/indexedScan", SIZE, [indexed] {
+        long long sum = 0;
+        indexed->forEach([&sum](int value) { sum += value; });
+        doNotOptimize(sum);
+    });
+
+    // Короткие списки целиком помещаются во встроенные ячейки и не выделяют память
+    suite.add("linked_list/smallLists", 100000, [] {
+        for (int i = 0; i < 10000; ++i) {
+            LinkedList<int> small;
+            for (int j = 0; j < 10; ++j) {
+                small.pushFront(i + j);
+            }
+            small.reverse();
+            doNotOptimize(small);
+        }
+    });
+}
+
+void printUsage() {
+    std::cout << "Использование: benchmark [--baseline <файл>] [--update] [--output <файл>]\n"
+              << "                 [--repetitions <n>] [--threshold <доля>] [--filter <подстрока>]\n"
+              << "  --baseline     файл базового уровня для сравнения (или для записи с --update)\n"
+              << "  --update       записать результаты как новый базовый уровень\n"
+              << "  --output       дополнительно сохранить результаты в файл\n"
+              << "  --repetitions  число повторений каждого замера (по умолчанию 15)\n"
+              << "  --threshold    допустимое замедление медианы (по умолчанию 0.1 = 10%)\n"
+              << "  --filter       выполнять только замеры, имя которых содержит подстроку\n"
+              << "Код возврата: 0 - замедлений нет, 1 - есть замедление, 2 - ошибка\n";
+}
+
+// Выравнивание заголовка по числу символов, а не байтов UTF-8
+std::string padded(const std::string& text, size_t width, bool left) {
+    size_t length = 0;
+    for (char symbol : text) {
+        length += (static_cast<unsigned char>(symbol) & 0xC0) != 0x80;
+    }
+    std::string padding(length < width ? width - length : 0, ' ');
+    return left ? text + padding : padding + text;
+}
+
+const char* statusName(BenchmarkComparison::Status status) {
+    switch (status) {
+        case BenchmarkComparison::Status::Regression:
+            return "ЗАМЕДЛЕНИЕ";
+        case BenchmarkComparison::Status::Improvement:
+            return "ускорение";
+        case BenchmarkComparison::Status::New:
+            return "новый";
+        default:
+            return "без изменений";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string baselinePath;
+    std::string outputPath;
+    std::string filter;
+    bool update = false;
+    size_t repetitions = 15;
+    double threshold = 0.1;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (argument == "--baseline" && hasValue) {
+                baselinePath = argv[++i];
+            } else if (argument == "--output" && hasValue) {
+                outputPath = argv[++i];
+            } else if (argument == "--filter" && hasValue) {
+                filter = argv[++i];
+            } else if (argument == "--repetitions" && hasValue) {
+                repetitions = std::stoul(argv[++i]);
+            } else if (argument == "--threshold" && hasValue) {
+                threshold = std::stod(argv[++i]);
+            } else if (argument == "--update") {
+                update = true;
+            } else {
+                printUsage();
+                return argument == "--help" ? 0 : 2;
+            }
+        }
+        if (update && baselinePath.empty()) {
+            std::cerr << "Ошибка: для --update нужен --baseline\n";
+            return 2;
+        }
+
+        BenchmarkSuite suite;
+        addFibonacciBenchmarks(suite);
+        addPalindromeBenchmarks(suite);
+        addLinkedListBenchmarks(suite);
+
+        auto results = suite.run(repetitions, filter);
+
+        if (!outputPath.empty()) {
+            BenchmarkJson::save(outputPath, results);
+        }
+        if (update) {
+            BenchmarkJson::save(baselinePath, results);
+            std::cout << "Базовый уровень записан в " << baselinePath << "\n";
+        }
+
+        std::vector<BenchmarkResult> baseline;
+        if (!baselinePath.empty() && !update) {
+            baseline = BenchmarkJson::load(baselinePath);
+        }
+        auto comparisons = BenchmarkStatistics::compare(baseline, results, threshold);
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << padded("Замер", 34, true) << padded("нс/операцию", 14, false) << padded("95% интервал", 26, false)
+                  << padded("база", 14, false) << padded("разница", 10, false) << "  статус\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            const auto& comparison = comparisons[i];
+            std::ostringstream interval;
+            interval << std::fixed << std::setprecision(2) << "[" << result.low << ", " << result.high << "]";
+            std::cout << std::left << std::setw(34) << result.name << std::right << std::setw(14) << result.median
+                      << std::setw(26) << interval.str();
+            if (comparison.status == BenchmarkComparison::Status::New) {
+                std::cout << std::setw(14) << "-" << std::setw(10) << "-";
+            } else {
+                std::cout << std::setw(14) << comparison.baselineMedian << std::setw(9)
+                          << (comparison.ratio() - 1.0) * 100.0 << "%";
+            }
+            std::cout << "  " << statusName(comparison.status) << "\n";
+        }
+
+        bool countersAvailable = std::any_of(results.begin(), results.end(), [](const BenchmarkResult& result) {
+            return result.counters.any();
+        });
+        if (countersAvailable) {
+            std::cout << "\nАппаратные счетчики (среднее по всем повторениям):\n";
+            for (const auto& result : results) {
+                PerfCounters::report(std::cout, result.name, result.counters, result.countedOperations);
+            }
+        } else if (!results.empty()) {
+            std::cout << "\nАппаратные счетчики недоступны (perf_event_open), выведено только время\n";
+        }
+
+        if (BenchmarkStatistics::hasRegression(comparisons)) {
+            std::cout << "Обнаружено замедление больше " << threshold * 100.0 << "% относительно базового уровня\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,627 @@
+// big_natural.h
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Неотрицательное целое произвольной длины.
+ *
+ * Число хранится цифрами по основанию 10^8 от младшей к старшей. Десятичное
+ * основание выбрано намеренно: перевод в строку становится линейным, и для
+ * вывода огромных чисел не нужен отдельный алгоритм смены системы счисления.
+ *
+ * Умножение выбирается по размеру операндов: столбиком для коротких чисел,
+ * Карацубой для средних и через теоретико-числовое преобразование (NTT)
+ * по простому модулю 2^64 - 2^32 + 1 для длинных
+ */
+class BigNatural {
+public:
+    static constexpr uint32_t kBase = 100000000;
+    static constexpr int kBaseDigits = 8;
+
+    // Пороги выбора алгоритма умножения (в цифрах по основанию 10^8)
+    static constexpr size_t kKaratsubaThreshold = 32;
+    static constexpr size_t kNttThreshold = 4096;
+
+private:
+    std::vector<uint32_t> limbs_;
+
+    // Простой модуль NTT: p = 2^64 - 2^32 + 1, 7 - первообразный корень
+    static constexpr uint64_t kModulus = 0xFFFFFFFF00000001ULL;
+    static constexpr uint64_t kGenerator = 7;
+    // Для NTT каждая цифра 10^8 делится на две половины по основанию 10^4
+    static constexpr uint32_t kNttBase = 10000;
+
+    void trim() {
+        while (!limbs_.empty() && limbs_.back() == 0) {
+            limbs_.pop_back();
+        }
+    }
+
+    static BigNatural fromLimbs(std::vector<uint32_t> limbs) {
+        BigNatural result;
+        result.limbs_ = std::move(limbs);
+        result.trim();
+        return result;
+    }
+
+    // ---- Арифметика по модулю p ----
+
+    static uint64_t modAdd(uint64_t a, uint64_t b) {
+        uint64_t sum = a + b;
+        // При переносе за 2^64 вычитание p по модулю 2^64 дает верный остаток
+        if (sum < a || sum >= kModulus) {
+            sum -= kModulus;
+        }
+        return sum;
+    }
+
+    static uint64_t modSub(uint64_t a, uint64_t b) {
+        return a >= b ? a - b : a - b + kModulus;
+    }
+
+    /**
+     * Умножение по модулю p без деления: 2^64 = 2^32 - 1 и 2^96 = -1 (mod p)
+     */
+    static uint64_t modMul(uint64_t a, uint64_t b) {
+        unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        uint64_t low = static_cast<uint64_t>(product);
+        uint64_t high = static_cast<uint64_t>(product >> 64);
+        uint64_t highHigh = high >> 32;
+        uint64_t highLow = high & 0xFFFFFFFFULL;
+
+        uint64_t result = low - highHigh;
+        if (low < highHigh) {
+            result -= 0xFFFFFFFFULL;
+        }
+        uint64_t term = highLow * 0xFFFFFFFFULL;
+        result += term;
+        if (result < term) {
+            result += 0xFFFFFFFFULL;
+        }
+        if (result >= kModulus) {
+            result -= kModulus;
+        }
+        return result;
+    }
+
+    static uint64_t modPow(uint64_t base, uint64_t exponent) {
+        uint64_t result = 1;
+        while (exponent > 0) {
+            if (exponent & 1) {
+                result = modMul(result, base);
+            }
+            base = modMul(base, base);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    /**
+     * Итеративное NTT на месте; размер - степень двойки не больше 2^32
+     */
+    static void ntt(std::vector<uint64_t>& values, bool inverse) {
+        size_t size = values.size();
+
+        for (size_t i = 1, j = 0; i < size; ++i) {
+            size_t bit = size >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(values[i], values[j]);
+            }
+        }
+
+        std::vector<uint64_t> twiddles(size / 2 > 0 ? size / 2 : 1);
+        for (size_t length = 2; length <= size; length <<= 1) {
+            uint64_t root = modPow(kGenerator, (kModulus - 1) / length);
+            if (inverse) {
+                root = modPow(root, kModulus - 2);
+            }
+
+            size_t half = length / 2;
+            twiddles[0] = 1;
+            for (size_t j = 1; j < half; ++j) {
+                twiddles[j] = modMul(twiddles[j - 1], root);
+            }
+
+            for (size_t start = 0; start < size; start += length) {
+                uint64_t* left = values.data() + start;
+                uint64_t* right = left + half;
+                for (size_t j = 0; j < half; ++j) {
+                    uint64_t u = left[j];
+                    uint64_t v = modMul(right[j], twiddles[j]);
+                    left[j] = modAdd(u, v);
+                    right[j] = modSub(u, v);
+                }
+            }
+        }
+
+        if (inverse) {
+            uint64_t sizeInverse = modPow(size % kModulus, kModulus - 2);
+            for (auto& value : values) {
+                value = modMul(value, sizeInverse);
+            }
+        }
+    }
+
+    // ---- Операции над массивами цифр ----
+
+    /**
+     * out[0 .. n + m) = a * b столбиком; out должен быть обнулен
+     */
+    static void multiplySchoolbookInto(const uint32_t* a, size_t n, const uint32_t* b, size_t m, uint32_t* out) {
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t carry = 0;
+            uint64_t digit = a[i];
+            if (digit == 0) {
+                continue;
+            }
+            for (size_t j = 0; j < m; ++j) {
+                uint64_t current = out[i + j] + digit * b[j] + carry;
+                carry = current / kBase;
+                out[i + j] = static_cast<uint32_t>(current % kBase);
+            }
+            for (size_t k = i + m; carry > 0; ++k) {
+                uint64_t current = out[k] + carry;
+                carry = current / kBase;
+                out[k] = static_cast<uint32_t>(current % kBase);
+            }
+        }
+    }
+
+    /**
+     * out[offset ..] += src; out должен вмещать результат вместе с переносом
+     */
+    static void addInto(uint32_t* out, size_t outSize, const uint32_t* src, size_t srcSize, size_t offset) {
+        uint32_t carry = 0;
+        size_t i = 0;
+        for (; i < srcSize; ++i) {
+            uint32_t current = out[offset + i] + src[i] + carry;
+            carry = current >= kBase;
+            out[offset + i] = carry ? current - kBase : current;
+        }
+        for (size_t k = offset + i; carry && k < outSize; ++k) {
+            uint32_t current = out[k] + carry;
+            carry = current >= kBase;
+            out[k] = carry ? current - kBase : current;
+        }
+    }
+
+    /**
+     * out -= src при условии out >= src
+     */
+    static void subtractInto(uint32_t* out, size_t outSize, const uint32_t* src, size_t srcSize) {
+        uint32_t borrow = 0;
+        size_t i = 0;
+        for (; i < srcSize; ++i) {
+            uint32_t subtrahend = src[i] + borrow;
+            borrow = out[i] < subtrahend;
+            out[i] = borrow ? out[i] + kBase - subtrahend : out[i] - subtrahend;
+        }
+        for (; borrow && i < outSize; ++i) {
+            borrow = out[i] == 0;
+            out[i] = borrow ? kBase - 1 : out[i] - 1;
+        }
+    }
+
+    /**
+     * out[0 .. n + m) = a * b методом Карацубы; out должен быть обнулен
+     */
+    static void multiplyKaratsubaInto(const uint32_t* a, size_t n, const uint32_t* b, size_t m, uint32_t* out) {
+        if (n < m) {
+            std::swap(a, b);
+            std::swap(n, m);
+        }
+        if (m < kKaratsubaThreshold) {
+            multiplySchoolbookInto(a, n, b, m, out);
+            return;
+        }
+
+        size_t split = (n + 1) / 2;
+        if (m <= split) {
+            // Сильно несбалансированные операнды: режем длинный на куски длины m
+            std::vector<uint32_t> partial(2 * m);
+            for (size_t start = 0; start < n; start += m) {
+                size_t length = std::min(m, n - start);
+                std::fill(partial.begin(), partial.end(), 0);
+                multiplyKaratsubaInto(a + start, length, b, m, partial.data());
+                addInto(out, n + m, partial.data(), length + m, start);
+            }
+            return;
+        }
+
+        const uint32_t* aLow = a;
+        const uint32_t* aHigh = a + split;
+        const uint32_t* bLow = b;
+        const uint32_t* bHigh = b + split;
+        size_t aHighSize = n - split;
+        size_t bHighSize = m - split;
+
+        // z0 = aLow * bLow и z2 = aHigh * bHigh сразу на свои места в out
+        multiplyKaratsubaInto(aLow, split, bLow, split, out);
+        multiplyKaratsubaInto(aHigh, aHighSize, bHigh, bHighSize, out + 2 * split);
+
+        // z1 = (aLow + aHigh) * (bLow + bHigh) - z0 - z2
+        std::vector<uint32_t> aSum(aLow, aLow + split);
+        aSum.push_back(0);
+        addInto(aSum.data(), aSum.size(), aHigh, aHighSize, 0);
+        std::vector<uint32_t> bSum(bLow, bLow + split);
+        bSum.push_back(0);
+        addInto(bSum.data(), bSum.size(), bHigh, bHighSize, 0);
+
+        std::vector<uint32_t> middle(aSum.size() + bSum.size());
+        multiplyKaratsubaInto(aSum.data(), aSum.size(), bSum.data(), bSum.size(), middle.data());
+        subtractInto(middle.data(), middle.size(), out, 2 * split);
+        subtractInto(middle.data(), middle.size(), out + 2 * split, aHighSize + bHighSize);
+
+        size_t middleSize = middle.size();
+        while (middleSize > 0 && middle[middleSize - 1] == 0) {
+            --middleSize;
+        }
+        addInto(out, n + m, middle.data(), middleSize, split);
+    }
+
+    /**
+     * a * b через NTT: цифры 10^8 делятся на половины 10^4, так что коэффициенты
+     * свертки не превосходят 10^8 * длина < p и восстанавливаются точно
+     */
+    static std::vector<uint32_t> multiplyNttLimbs(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        size_t resultSize = 2 * (a.size() + b.size());
+        size_t size = 1;
+        while (size < resultSize) {
+            size <<= 1;
+        }
+
+        auto split = [size](const std::vector<uint32_t>& limbs) {
+            std::vector<uint64_t> values(size, 0);
+            for (size_t i = 0; i < limbs.size(); ++i) {
+                values[2 * i] = limbs[i] % kNttBase;
+                values[2 * i + 1] = limbs[i] / kNttBase;
+            }
+            return values;
+        };
+
+        std::vector<uint64_t> left = split(a);
+        ntt(left, false);
+        if (&a == &b) {
+            // Возведение в квадрат: достаточно одного прямого преобразования
+            for (auto& value : left) {
+                value = modMul(value, value);
+            }
+        } else {
+            std::vector<uint64_t> right = split(b);
+            ntt(right, false);
+            for (size_t i = 0; i < size; ++i) {
+                left[i] = modMul(left[i], right[i]);
+            }
+        }
+        ntt(left, true);
+
+        std::vector<uint32_t> result(a.size() + b.size(), 0);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < result.size(); ++i) {
+            carry += left[2 * i];
+            uint64_t low = carry % kNttBase;
+            carry /= kNttBase;
+            carry += left[2 * i + 1];
+            uint64_t high = carry % kNttBase;
+            carry /= kNttBase;
+            result[i] = static_cast<uint32_t>(high * kNttBase + low);
+        }
+        return result;
+    }
+
+    /**
+     * Приближенное значение по трем старшим цифрам: x ~ mantissa * 10^(8 * exponent)
+     */
+    [[nodiscard]] double leading(size_t& exponent) const {
+        size_t take = std::min<size_t>(3, limbs_.size());
+        exponent = limbs_.size() - take;
+        double mantissa = 0;
+        for (size_t i = limbs_.size(); i-- > exponent;) {
+            mantissa = mantissa * kBase + limbs_[i];
+        }
+        return mantissa;
+    }
+
+    /**
+     * x * 10^(8 * count) - сдвиг на count цифр основания
+     */
+    static BigNatural shifted(const BigNatural& x, size_t count) {
+        if (x.isZero()) {
+            return x;
+        }
+        std::vector<uint32_t> limbs(count, 0);
+        limbs.insert(limbs.end(), x.limbs_.begin(), x.limbs_.end());
+        return fromLimbs(std::move(limbs));
+    }
+
+    /**
+     * Оценка очередной цифры корня d - наибольшей с (2rB + d) * d <= remainder,
+     * где r - уже найденная часть корня. Из квадратного уравнения
+     * d = R / (rB + sqrt((rB)^2 + R)); эта форма не теряет точность при больших r
+     */
+    static uint32_t estimateRootDigit(const BigNatural& remainder, const BigNatural& root) {
+        size_t remainderExponent = 0;
+        double remainderLeading = remainder.leading(remainderExponent);
+
+        double digit;
+        if (root.isZero()) {
+            digit = std::sqrt(remainderLeading * std::pow(static_cast<double>(kBase), remainderExponent));
+        } else {
+            size_t rootExponent = 0;
+            double rootLeading = root.leading(rootExponent);
+            // q = R / (rB) и R / (rB)^2 = q / (rB); при длинном r второе слагаемое пренебрежимо мало
+            double quotient = remainderLeading / rootLeading *
+                              std::pow(static_cast<double>(kBase),
+                                       static_cast<double>(remainderExponent) - static_cast<double>(rootExponent) - 1);
+            double ratio = quotient / (rootLeading * std::pow(static_cast<double>(kBase), rootExponent + 1.0));
+            digit = quotient / (1 + std::sqrt(1 + ratio));
+        }
+
+        if (!(digit >= 0)) {
+            return 0;
+        }
+        return digit >= kBase - 1 ? kBase - 1 : static_cast<uint32_t>(digit);
+    }
+
+    /**
+     * Целый квадратный корень и остаток столбиком по основанию 10^8:
+     * цифры числа сносятся парами, и на каждом шаге подбирается одна цифра корня
+     */
+    static BigNatural squareRootRemainder(const BigNatural& value, BigNatural& remainder) {
+        BigNatural root;
+        remainder = BigNatural();
+        size_t size = value.limbs_.size();
+
+        for (size_t group = (size + 1) / 2; group-- > 0;) {
+            std::vector<uint32_t> limbs{value.limbs_[2 * group], 2 * group + 1 < size ? value.limbs_[2 * group + 1] : 0};
+            limbs.insert(limbs.end(), remainder.limbs_.begin(), remainder.limbs_.end());
+            remainder = fromLimbs(std::move(limbs));
+
+            BigNatural doubledRoot = shifted(root * 2u, 1);
+            auto taken = [&doubledRoot](uint32_t digit) {
+                return (doubledRoot + BigNatural(digit)) * digit;
+            };
+
+            // Оценка точна с точностью до нескольких единиц, уточняем точными проверками
+            uint32_t digit = estimateRootDigit(remainder, root);
+            BigNatural subtrahend = taken(digit);
+            while (remainder < subtrahend) {
+                subtrahend = taken(--digit);
+            }
+            while (digit + 1 < kBase) {
+                BigNatural next = taken(digit + 1);
+                if (remainder < next) {
+                    break;
+                }
+                ++digit;
+                subtrahend = std::move(next);
+            }
+
+            remainder = remainder - subtrahend;
+            root = shifted(root, 1) + BigNatural(digit);
+        }
+
+        return root;
+    }
+
+public:
+    BigNatural() = default;
+
+    BigNatural(uint64_t value) {
+        while (value > 0) {
+            limbs_.push_back(static_cast<uint32_t>(value % kBase));
+            value /= kBase;
+        }
+    }
+
+    /**
+     * Разбор десятичной строки
+     *
+     * @throws std::invalid_argument если строка пуста или содержит не цифры
+     */
+    static BigNatural fromString(const std::string& text) {
+        if (text.empty() || !std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            throw std::invalid_argument("Строка не является десятичным числом: " + text);
+        }
+
+        std::vector<uint32_t> limbs;
+        limbs.reserve(text.size() / kBaseDigits + 1);
+        for (size_t end = text.size(); end > 0;) {
+            size_t start = end > static_cast<size_t>(kBaseDigits) ? end - kBaseDigits : 0;
+            limbs.push_back(static_cast<uint32_t>(std::stoul(text.substr(start, end - start))));
+            end = start;
+        }
+        return fromLimbs(std::move(limbs));
+    }
+
+    [[nodiscard]] bool isZero() const {
+        return limbs_.empty();
+    }
+
+    /**
+     * Количество цифр по основанию 10^8
+     */
+    [[nodiscard]] size_t limbCount() const {
+        return limbs_.size();
+    }
+
+    /**
+     * Количество десятичных цифр (для нуля - одна)
+     */
+    [[nodiscard]] size_t digitCount() const {
+        if (limbs_.empty()) {
+            return 1;
+        }
+        size_t digits = (limbs_.size() - 1) * kBaseDigits;
+        for (uint32_t top = limbs_.back(); top > 0; top /= 10) {
+            ++digits;
+        }
+        return digits;
+    }
+
+    /**
+     * Десятичная запись за линейное время
+     */
+    [[nodiscard]] std::string toString() const {
+        if (limbs_.empty()) {
+            return "0";
+        }
+
+        std::string result = std::to_string(limbs_.back());
+        result.reserve(digitCount());
+        for (size_t i = limbs_.size() - 1; i-- > 0;) {
+            char block[kBaseDigits];
+            uint32_t limb = limbs_[i];
+            for (int d = kBaseDigits - 1; d >= 0; --d) {
+                block[d] = static_cast<char>('0' + limb % 10);
+                limb /= 10;
+            }
+            result.append(block, kBaseDigits);
+        }
+        return result;
+    }
+
+    friend bool operator==(const BigNatural& a, const BigNatural& b) {
+        return a.limbs_ == b.limbs_;
+    }
+
+    friend bool operator!=(const BigNatural& a, const BigNatural& b) {
+        return !(a == b);
+    }
+
+    friend bool operator<(const BigNatural& a, const BigNatural& b) {
+        if (a.limbs_.size() != b.limbs_.size()) {
+            return a.limbs_.size() < b.limbs_.size();
+        }
+        return std::lexicographical_compare(a.limbs_.rbegin(), a.limbs_.rend(), b.limbs_.rbegin(), b.limbs_.rend());
+    }
+
+    friend BigNatural operator+(const BigNatural& a, const BigNatural& b) {
+        const BigNatural& longer = a.limbs_.size() >= b.limbs_.size() ? a : b;
+        const BigNatural& shorter = a.limbs_.size() >= b.limbs_.size() ? b : a;
+
+        std::vector<uint32_t> limbs(longer.limbs_);
+        limbs.push_back(0);
+        addInto(limbs.data(), limbs.size(), shorter.limbs_.data(), shorter.limbs_.size(), 0);
+        return fromLimbs(std::move(limbs));
+    }
+
+    /**
+     * Разность a - b
+     *
+     * @throws std::underflow_error если a < b
+     */
+    friend BigNatural operator-(const BigNatural& a, const BigNatural& b) {
+        if (a < b) {
+            throw std::underflow_error("Вычитание большего числа из меньшего");
+        }
+        std::vector<uint32_t> limbs(a.limbs_);
+        subtractInto(limbs.data(), limbs.size(), b.limbs_.data(), b.limbs_.size());
+        return fromLimbs(std::move(limbs));
+    }
+
+    /**
+     * Умножение с выбором алгоритма по длине меньшего операнда
+     */
+    friend BigNatural operator*(const BigNatural& a, const BigNatural& b) {
+        size_t shorter = std::min(a.limbs_.size(), b.limbs_.size());
+        if (shorter == 0) {
+            return BigNatural();
+        }
+        if (shorter < kKaratsubaThreshold) {
+            return multiplySchoolbook(a, b);
+        }
+        if (shorter < kNttThreshold) {
+            return multiplyKaratsuba(a, b);
+        }
+        return multiplyNtt(a, b);
+    }
+
+    /**
+     * Умножение на небольшое число
+     */
+    friend BigNatural operator*(const BigNatural& a, uint32_t factor) {
+        std::vector<uint32_t> limbs;
+        limbs.reserve(a.limbs_.size() + 2);
+        uint64_t carry = 0;
+        for (uint32_t limb : a.limbs_) {
+            uint64_t current = static_cast<uint64_t>(limb) * factor + carry;
+            limbs.push_back(static_cast<uint32_t>(current % kBase));
+            carry = current / kBase;
+        }
+        while (carry > 0) {
+            limbs.push_back(static_cast<uint32_t>(carry % kBase));
+            carry /= kBase;
+        }
+        return fromLimbs(std::move(limbs));
+    }
+
+    /**
+     * Целая часть квадратного корня. Корень извлекается столбиком за O(n^2)
+     * от длины числа - для проверок единичных значений этого достаточно
+     */
+    static BigNatural sqrt(const BigNatural& value) {
+        BigNatural remainder;
+        return squareRootRemainder(value, remainder);
+    }
+
+    /**
+     * Проверка, является ли число точным квадратом.
+     * Младшая цифра основания 10^8 дает остаток по модулю 256, а квадраты
+     * принимают лишь 44 из 256 остатков, поэтому большинство чисел
+     * отсеивается без извлечения корня
+     */
+    static bool isPerfectSquare(const BigNatural& value) {
+        if (value.isZero()) {
+            return true;
+        }
+        static const std::array<bool, 256> squareResidues = [] {
+            std::array<bool, 256> residues{};
+            for (uint32_t x = 0; x < 256; ++x) {
+                residues[(x * x) % 256] = true;
+            }
+            return residues;
+        }();
+        if (!squareResidues[value.limbs_[0] % 256]) {
+            return false;
+        }
+
+        BigNatural remainder;
+        squareRootRemainder(value, remainder);
+        return remainder.isZero();
+    }
+
+    /**
+     * Отдельные алгоритмы умножения - для тестов и бенчмарков
+     */
+    static BigNatural multiplySchoolbook(const BigNatural& a, const BigNatural& b) {
+        std::vector<uint32_t> limbs(a.limbs_.size() + b.limbs_.size(), 0);
+        multiplySchoolbookInto(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(), b.limbs_.size(), limbs.data());
+        return fromLimbs(std::move(limbs));
+    }
+
+    static BigNatural multiplyKaratsuba(const BigNatural& a, const BigNatural& b) {
+        std::vector<uint32_t> limbs(a.limbs_.size() + b.limbs_.size(), 0);
+        multiplyKaratsubaInto(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(), b.limbs_.size(), limbs.data());
+        return fromLimbs(std::move(limbs));
+    }
+
+    static BigNatural multiplyNtt(const BigNatural& a, const BigNatural& b) {
+        if (a.isZero() || b.isZero()) {
+            return BigNatural();
+        }
+        return fromLimbs(multiplyNttLimbs(a.limbs_, b.limbs_));
+    }
+};
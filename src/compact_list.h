@@ -0,0 +1,246 @@
+// compact_list.h
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "linked_list.h"
+
+/**
+ * Односвязный список с компактными узлами. Узел - элемент и 32-битный номер
+ * следующего узла вместо shared_ptr (16 байт) и управляющего блока (16 байт):
+ * все узлы лежат в одном векторе, поэтому отдельного выделения памяти
+ * и служебного заголовка malloc на узел нет. Элемент идет первым
+ * и выровнен, как в векторе T; номер следующего узла занимает место
+ * после него (до выравнивания узла по alignof(T)).
+ *
+ * Номера узлов не меняются при росте вектора, но ссылки на элементы
+ * при росте становятся недействительными, поэтому список не выдает узлов
+ * наружу. Освобожденные узлы идут в список свободных и переиспользуются;
+ * shrinkToFit() переупорядочивает узлы по порядку списка и отдает лишнюю память.
+ * Элементы должны быть конструируемы по умолчанию: освобожденный узел
+ * хранит T(), чтобы строки сразу отдавали свои буферы
+ *
+ * @tparam T Тип элементов
+ */
+template <typename T>
+class CompactList {
+public:
+    using Index = uint32_t;
+
+    // Номер "нет узла"; узлов может быть не больше kNull
+    static constexpr Index kNull = UINT32_MAX;
+
+private:
+    struct Node {
+        T data;
+        Index next;
+    };
+
+    std::vector<Node> nodes_;
+    Index head_;
+    Index tail_;
+    // Голова списка свободных узлов (цепочка через next)
+    Index free_;
+    size_t size_;
+
+    template <typename Value>
+    Index allocate(Value&& value) {
+        if (free_ != kNull) {
+            Index slot = free_;
+            free_ = nodes_[slot].next;
+            nodes_[slot].data = std::forward<Value>(value);
+            nodes_[slot].next = kNull;
+            return slot;
+        }
+        if (nodes_.size() >= kNull) {
+            throw std::length_error("Превышен наибольший размер компактного списка");
+        }
+        nodes_.push_back(Node{std::forward<Value>(value), kNull});
+        return static_cast<Index>(nodes_.size() - 1);
+    }
+
+    void release(Index slot) {
+        nodes_[slot].data = T();
+        nodes_[slot].next = free_;
+        free_ = slot;
+    }
+
+public:
+    CompactList() : head_(kNull), tail_(kNull), free_(kNull), size_(0) {}
+
+    /**
+     * Создание списка из вектора значений: узлы лежат в памяти по порядку списка
+     */
+    explicit CompactList(const std::vector<T>& values) : CompactList() {
+        reserve(values.size());
+        for (const T& value : values) {
+            pushBack(value);
+        }
+    }
+
+    /**
+     * Резервирование места под count узлов без перевыделений
+     */
+    void reserve(size_t count) {
+        nodes_.reserve(count);
+    }
+
+    /**
+     * Добавление элемента в начало списка
+     *
+     * @throws std::length_error если узлов больше kNull
+     */
+    void pushFront(T value) {
+        Index slot = allocate(std::move(value));
+        nodes_[slot].next = head_;
+        head_ = slot;
+        if (tail_ == kNull) {
+            tail_ = slot;
+        }
+        ++size_;
+    }
+
+    /**
+     * Добавление элемента в конец списка за O(1)
+     *
+     * @throws std::length_error если узлов больше kNull
+     */
+    void pushBack(T value) {
+        Index slot = allocate(std::move(value));
+        if (tail_ == kNull) {
+            head_ = slot;
+        } else {
+            nodes_[tail_].next = slot;
+        }
+        tail_ = slot;
+        ++size_;
+    }
+
+    /**
+     * Удаление первого элемента; узел переходит в список свободных
+     *
+     * @throws std::out_of_range если список пуст
+     */
+    void popFront() {
+        if (head_ == kNull) {
+            throw std::out_of_range("Удаление из пустого списка");
+        }
+        Index slot = head_;
+        head_ = nodes_[slot].next;
+        if (head_ == kNull) {
+            tail_ = kNull;
+        }
+        release(slot);
+        --size_;
+    }
+
+    /**
+     * Первый элемент
+     *
+     * @throws std::out_of_range если список пуст
+     */
+    [[nodiscard]] const T& front() const {
+        if (head_ == kNull) {
+            throw std::out_of_range("Обращение к элементу пустого списка");
+        }
+        return nodes_[head_].data;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] bool isEmpty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * Очистка списка с освобождением памяти узлов
+     */
+    void clear() {
+        std::vector<Node>().swap(nodes_);
+        head_ = tail_ = free_ = kNull;
+        size_ = 0;
+    }
+
+    /**
+     * Разворот списка перестановкой номеров, без выделения памяти
+     */
+    void reverse() {
+        Index prev = kNull;
+        Index current = head_;
+        tail_ = head_;
+        while (current != kNull) {
+            Index next = nodes_[current].next;
+            nodes_[current].next = prev;
+            prev = current;
+            current = next;
+        }
+        head_ = prev;
+    }
+
+    /**
+     * Обход элементов по порядку
+     *
+     * @param function Вызывается для каждого элемента как function(const T&)
+     */
+    template <typename Function>
+    void forEach(Function function) const {
+        for (Index slot = head_; slot != kNull; slot = nodes_[slot].next) {
+            function(nodes_[slot].data);
+        }
+    }
+
+    [[nodiscard]] std::vector<T> toVector() const {
+        std::vector<T> result;
+        result.reserve(size_);
+        forEach([&result](const T& value) {
+            result.push_back(value);
+        });
+        return result;
+    }
+
+    /**
+     * Перекладка узлов в порядке списка в вектор точного размера: свободные
+     * узлы и лишняя емкость отдаются, обход снова идет по памяти подряд
+     */
+    void shrinkToFit() {
+        std::vector<Node> packed;
+        packed.reserve(size_);
+        for (Index slot = head_; slot != kNull; slot = nodes_[slot].next) {
+            Index next = static_cast<Index>(packed.size() + 1);
+            packed.push_back(Node{std::move(nodes_[slot].data), next});
+        }
+        if (!packed.empty()) {
+            packed.back().next = kNull;
+        }
+        nodes_ = std::move(packed);
+        head_ = size_ > 0 ? 0 : kNull;
+        tail_ = size_ > 0 ? static_cast<Index>(size_ - 1) : kNull;
+        free_ = kNull;
+    }
+
+    /**
+     * Память, занятая списком, в байтах: объект, вектор узлов по емкости
+     * (вместе со свободными узлами) и память элементов-строк
+     */
+    [[nodiscard]] MemoryUsage memoryUsage() const {
+        MemoryUsage usage;
+        usage.object = sizeof(*this);
+        usage.nodes = nodes_.capacity() * sizeof(Node);
+        forEach([&usage](const T& value) {
+            usage.payload += MemoryUsage::payloadBytes(value);
+        });
+        return usage;
+    }
+
+    /**
+     * Размер узла в байтах
+     */
+    static constexpr size_t nodeSize() {
+        return sizeof(Node);
+    }
+};
@@ -0,0 +1,282 @@
+// doubly_linked_list.h
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Двусвязный список с разворотом за O(1).
+ * Каждый узел хранит две ссылки links[0] и links[1], а список - флаг направления.
+ * Разворот только меняет флаг: ссылка, которая была "следующей", становится
+ * "предыдущей", и наоборот. Все операции читают ссылки с учетом флага
+ */
+template <typename T>
+class DoublyLinkedList {
+public:
+    struct Node {
+        T data;
+        Node* links[2];
+
+        explicit Node(T value) : data(std::move(value)), links{nullptr, nullptr} {}
+    };
+
+    /**
+     * Итератор по элементам в текущем (логическом) порядке
+     */
+    class ConstIterator {
+    private:
+        const Node* node_;
+        int forward_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator(const Node* node, int forward) : node_(node), forward_(forward) {}
+
+        reference operator*() const {
+            return node_->data;
+        }
+
+        pointer operator->() const {
+            return &node_->data;
+        }
+
+        ConstIterator& operator++() {
+            node_ = node_->links[forward_];
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return node_ == other.node_;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return node_ != other.node_;
+        }
+    };
+
+private:
+    // ends_[0] и ends_[1] - концы списка в физическом порядке
+    Node* ends_[2];
+    size_t size_;
+    bool reversed_;
+
+    // Индекс ссылки "вперед" и "назад" в текущем направлении
+    [[nodiscard]] int forward() const {
+        return reversed_ ? 1 : 0;
+    }
+
+    [[nodiscard]] int backward() const {
+        return reversed_ ? 0 : 1;
+    }
+
+    /**
+     * Вставка узла со стороны side: backward() - в начало, forward() - в конец
+     */
+    void insertAtEnd(Node* node, int side) {
+        // Сторона начала списка хранится в ends_[forward()], конца - в ends_[backward()]
+        int endIndex = side == backward() ? forward() : backward();
+        Node* oldEnd = ends_[endIndex];
+
+        node->links[side] = nullptr;
+        node->links[1 - side] = oldEnd;
+        if (oldEnd) {
+            oldEnd->links[side] = node;
+        } else {
+            ends_[1 - endIndex] = node;
+        }
+        ends_[endIndex] = node;
+        ++size_;
+    }
+
+    /**
+     * Удаление крайнего узла; логика симметрична insertAtEnd
+     */
+    T removeAtEnd(int side) {
+        if (size_ == 0) {
+            throw std::out_of_range("Удаление из пустого списка");
+        }
+
+        int endIndex = side == backward() ? forward() : backward();
+        Node* node = ends_[endIndex];
+        Node* neighbour = node->links[1 - side];
+
+        if (neighbour) {
+            neighbour->links[side] = nullptr;
+        } else {
+            ends_[1 - endIndex] = nullptr;
+        }
+        ends_[endIndex] = neighbour;
+        --size_;
+
+        T value = std::move(node->data);
+        delete node;
+        return value;
+    }
+
+public:
+    DoublyLinkedList() : ends_{nullptr, nullptr}, size_(0), reversed_(false) {}
+
+    /**
+     * Создание списка из вектора значений
+     */
+    explicit DoublyLinkedList(const std::vector<T>& values) : DoublyLinkedList() {
+        for (const auto& value : values) {
+            pushBack(value);
+        }
+    }
+
+    DoublyLinkedList(const DoublyLinkedList& other) : DoublyLinkedList() {
+        for (const auto& value : other) {
+            pushBack(value);
+        }
+    }
+
+    DoublyLinkedList(DoublyLinkedList&& other) noexcept
+        : ends_{other.ends_[0], other.ends_[1]}, size_(other.size_), reversed_(other.reversed_) {
+        other.ends_[0] = other.ends_[1] = nullptr;
+        other.size_ = 0;
+        other.reversed_ = false;
+    }
+
+    DoublyLinkedList& operator=(DoublyLinkedList other) noexcept {
+        std::swap(ends_[0], other.ends_[0]);
+        std::swap(ends_[1], other.ends_[1]);
+        std::swap(size_, other.size_);
+        std::swap(reversed_, other.reversed_);
+        return *this;
+    }
+
+    ~DoublyLinkedList() {
+        clear();
+    }
+
+    /**
+     * Добавление элемента в начало списка
+     */
+    void pushFront(T value) {
+        insertAtEnd(new Node(std::move(value)), backward());
+    }
+
+    /**
+     * Добавление элемента в конец списка
+     */
+    void pushBack(T value) {
+        insertAtEnd(new Node(std::move(value)), forward());
+    }
+
+    /**
+     * Удаление первого элемента за O(1)
+     *
+     * @return Удаленное значение
+     * @throws std::out_of_range если список пуст
+     */
+    T popFront() {
+        return removeAtEnd(backward());
+    }
+
+    /**
+     * Удаление последнего элемента за O(1)
+     *
+     * @return Удаленное значение
+     * @throws std::out_of_range если список пуст
+     */
+    T popBack() {
+        return removeAtEnd(forward());
+    }
+
+    /**
+     * Первый элемент списка
+     *
+     * @throws std::out_of_range если список пуст
+     */
+    [[nodiscard]] const T& front() const {
+        if (size_ == 0) {
+            throw std::out_of_range("Обращение к элементу пустого списка");
+        }
+        return ends_[forward()]->data;
+    }
+
+    /**
+     * Последний элемент списка
+     *
+     * @throws std::out_of_range если список пуст
+     */
+    [[nodiscard]] const T& back() const {
+        if (size_ == 0) {
+            throw std::out_of_range("Обращение к элементу пустого списка");
+        }
+        return ends_[backward()]->data;
+    }
+
+    /**
+     * Разворот списка за O(1): меняется только флаг направления
+     */
+    void reverse() {
+        reversed_ = !reversed_;
+    }
+
+    /**
+     * Получение размера списка
+     */
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    /**
+     * Проверка пустой ли список
+     */
+    [[nodiscard]] bool isEmpty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * Очистка списка
+     */
+    void clear() {
+        Node* current = ends_[0];
+        while (current) {
+            Node* next = current->links[0];
+            delete current;
+            current = next;
+        }
+        ends_[0] = ends_[1] = nullptr;
+        size_ = 0;
+        reversed_ = false;
+    }
+
+    [[nodiscard]] ConstIterator begin() const {
+        return ConstIterator(ends_[forward()], forward());
+    }
+
+    [[nodiscard]] ConstIterator end() const {
+        return ConstIterator(nullptr, forward());
+    }
+
+    /**
+     * Преобразование списка в вектор
+     */
+    [[nodiscard]] std::vector<T> toVector() const {
+        std::vector<T> result;
+        result.reserve(size_);
+
+        for (const auto& value : *this) {
+            result.push_back(value);
+        }
+
+        return result;
+    }
+};
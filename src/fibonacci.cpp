@@ -1,48 +1,3 @@
-// fibonacci.h
-#pragma once
-
-#include <vector>
-#include <stdexcept>
-#include <limits>
-
-class FibonacciGenerator {
-public:
-    /**
-     * Генерирует контейнер с первыми n чисел Фибоначчи
-     * 
-     * @param n Количество чисел Фибоначчи для генерации
-     * @return Вектор с первыми n числами Фибоначчи
-     * @throws std::invalid_argument если n равно 0
-     * @throws std::overflow_error если вычисление приводит к переполнению
-     */
-    static std::vector<unsigned long long> generateFibonacci(unsigned int n) {
-        if (n == 0) {
-            throw std::invalid_argument("Количество чисел должно быть больше 0");
-        }
-        
-        std::vector<unsigned long long> fibonacci;
-        fibonacci.reserve(n); // Резервируем память для оптимизации
-        
-        // Первые два числа Фибоначчи
-        fibonacci.push_back(0);
-        if (n > 1) {
-            fibonacci.push_back(1);
-        }
-        
-        // Генерируем остальные числа
-        for (unsigned int i = 2; i < n; ++i) {
-            // Проверка на переполнение перед вычислением
-            if (fibonacci[i-1] > std::numeric_limits<unsigned long long>::max() - fibonacci[i-2]) {
-                throw std::overflow_error("Переполнение при вычислении числа Фибоначчи");
-            }
-            
-            fibonacci.push_back(fibonacci[i-1] + fibonacci[i-2]);
-        }
-        
-        return fibonacci;
-    }
-};
-
 // fibonacci_test.cpp
 #include <gtest/gtest.h>
 #include "fibonacci.h"
@@ -0,0 +1,280 @@
+// fibonacci.h
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include <limits>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define FIBONACCI_HAS_AVX512_BATCH 1
+#endif
+
+#include "big_natural.h"
+#include "linear_recurrence.h"
+#include "trace.h"
+
+/**
+ * Таблица чисел Фибоначчи, помещающихся в uint64_t, разложенная по длине в битах.
+ * Так как F(k + 2) = F(k + 1) + F(k) >= 2F(k), в каждый диапазон [2^b, 2^(b+1))
+ * попадает не больше двух различных чисел, и ячейка b хранит ровно два слота.
+ * Свободные слоты заполнены нулем: 0 лежит только в ячейке 0, где оба слота заняты
+ */
+constexpr std::array<uint64_t, 128> makeFibonacciBitLengthTable() {
+    std::array<uint64_t, 128> table{};
+    std::array<bool, 128> used{};
+    uint64_t previous = 0;
+    uint64_t current = 1;
+    for (int i = 0; i < 94; ++i) {
+        uint64_t value = previous;
+        int bucket = 63;
+        while (bucket > 0 && !((value | 1) >> bucket)) {
+            --bucket;
+        }
+        // F(1) = F(2) = 1 - второй раз не добавляем
+        bool present = (used[2 * bucket] && table[2 * bucket] == value) ||
+                       (used[2 * bucket + 1] && table[2 * bucket + 1] == value);
+        if (!present) {
+            int slot = used[2 * bucket] ? 2 * bucket + 1 : 2 * bucket;
+            if (used[slot]) {
+                throw std::logic_error("Больше двух чисел Фибоначчи одной длины");
+            }
+            table[slot] = value;
+            used[slot] = true;
+        }
+        if (i < 93) {
+            uint64_t next = previous + current;
+            previous = current;
+            current = next;
+        }
+    }
+    return table;
+}
+
+class FibonacciGenerator {
+private:
+    static constexpr std::array<uint64_t, 128> kFibonacciByBitLength = makeFibonacciBitLengthTable();
+    
+    /**
+     * Генерация по модулю 2^(разрядность T) без ветвлений.
+     * Вместо F(i) = F(i-1) + F(i-2), где каждый член зависит от предыдущего,
+     * используется тождество F(i) = L(8) * F(i-8) - F(i-16) с L(8) = 47:
+     * ближайшая зависимость отстоит на 8 элементов, и компилятор
+     * векторизует цикл. В кольце вычетов тождество остается верным
+     */
+    template <typename T>
+    static std::vector<T> generateFibonacciWrapping(unsigned int n) {
+        static_assert(T(-1) > T(0), "Циклическая арифметика определена только для беззнаковых типов");
+        if (n == 0) {
+            throw std::invalid_argument("Количество чисел должно быть больше 0");
+        }
+        
+        std::vector<T> fibonacci(n);
+        T* data = fibonacci.data();
+        unsigned int prefix = std::min(n, 16u);
+        if (n > 1) {
+            data[1] = 1;
+        }
+        for (unsigned int i = 2; i < prefix; ++i) {
+            data[i] = static_cast<T>(data[i - 1] + data[i - 2]);
+        }
+        for (size_t i = 16; i < n; ++i) {
+            data[i] = static_cast<T>(static_cast<T>(47) * data[i - 8] - data[i - 16]);
+        }
+        
+        return fibonacci;
+    }
+    
+    static void isFibonacciBatchScalar(const uint64_t* values, size_t count, uint8_t* result) {
+        for (size_t i = 0; i < count; ++i) {
+            result[i] = static_cast<uint8_t>(isFibonacci(values[i]));
+        }
+    }
+    
+#ifdef FIBONACCI_HAS_AVX512_BATCH
+    /**
+     * Есть ли у процессора команды для isFibonacciBatchAvx512; проверяется один раз
+     */
+    static bool hasAvx512Batch() {
+        static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") &&
+                                      __builtin_cpu_supports("bmi2");
+        return supported;
+    }
+    
+    /**
+     * Выбор из 64 значений, лежащих по 8 в table[0..7], по номерам bucket (0..63):
+     * vpermt2q выбирает из пары регистров по младшим четырем битам номера,
+     * четыре результата сводятся смешиванием по битам 4 и 5
+     */
+    __attribute__((target("avx512f")))
+    static __m512i lookupBuckets(const __m512i* table, __m512i bucket) {
+        __mmask8 bit4 = _mm512_test_epi64_mask(bucket, _mm512_set1_epi64(16));
+        __mmask8 bit5 = _mm512_test_epi64_mask(bucket, _mm512_set1_epi64(32));
+        __m512i low = _mm512_mask_blend_epi64(bit4, _mm512_permutex2var_epi64(table[0], bucket, table[1]),
+                                              _mm512_permutex2var_epi64(table[2], bucket, table[3]));
+        __m512i high = _mm512_mask_blend_epi64(bit4, _mm512_permutex2var_epi64(table[4], bucket, table[5]),
+                                               _mm512_permutex2var_epi64(table[6], bucket, table[7]));
+        return _mm512_mask_blend_epi64(bit5, low, high);
+    }
+    
+    /**
+     * Та же проверка по таблице для восьми чисел сразу. Таблица (1 КБ) целиком
+     * лежит в 16 регистрах: первые и вторые слоты ячеек отдельно. vplzcntq дает
+     * длину каждого числа в битах, lookupBuckets - оба слота его ячейки,
+     * маска совпадений раскладывается в восемь байтов результата через pdep.
+     * Хвост короче восьми чисел проверяется по одному
+     */
+    __attribute__((target("avx512f,avx512cd,bmi2")))
+    static void isFibonacciBatchAvx512(const uint64_t* values, size_t count, uint8_t* result) {
+        const __m512i one = _mm512_set1_epi64(1);
+        const __m512i evenSlots = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+        const __m512i oddSlots = _mm512_add_epi64(evenSlots, one);
+        __m512i firstSlots[8];
+        __m512i secondSlots[8];
+        for (size_t part = 0; part < 8; ++part) {
+            __m512i low = _mm512_loadu_si512(kFibonacciByBitLength.data() + 16 * part);
+            __m512i high = _mm512_loadu_si512(kFibonacciByBitLength.data() + 16 * part + 8);
+            firstSlots[part] = _mm512_permutex2var_epi64(low, evenSlots, high);
+            secondSlots[part] = _mm512_permutex2var_epi64(low, oddSlots, high);
+        }
+        
+        const __m512i highestBit = _mm512_set1_epi64(63);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m512i value = _mm512_loadu_si512(values + i);
+            __m512i bucket = _mm512_sub_epi64(highestBit, _mm512_lzcnt_epi64(_mm512_or_si512(value, one)));
+            __mmask8 match = _mm512_cmpeq_epi64_mask(value, lookupBuckets(firstSlots, bucket)) |
+                             _mm512_cmpeq_epi64_mask(value, lookupBuckets(secondSlots, bucket));
+            uint64_t bytes = _pdep_u64(match, 0x0101010101010101ULL);
+            std::memcpy(result + i, &bytes, sizeof(bytes));
+        }
+        isFibonacciBatchScalar(values + i, count - i, result + i);
+    }
+#endif
+
+public:
+    /**
+     * Генерирует контейнер с первыми n чисел Фибоначчи.
+     * Частный случай LinearRecurrence с коэффициентами 1, 1 и началом 0, 1.
+     * Политика выбирается при компиляции: с WrappingArithmetic цикл
+     * не содержит ветвлений и векторизуется
+     * 
+     * @tparam T Тип чисел: например, uint32_t для компактного хранения
+     *           или unsigned __int128 для 187 чисел вместо 94
+     * @tparam OverflowPolicy CheckedArithmetic (исключение), SaturatingArithmetic
+     *                        (максимум типа) или WrappingArithmetic (по модулю 2^разрядность)
+     * @param n Количество чисел Фибоначчи для генерации
+     * @return Вектор с первыми n числами Фибоначчи
+     * @throws std::invalid_argument если n равно 0
+     * @throws std::overflow_error если вычисление приводит к переполнению (для CheckedArithmetic)
+     */
+    template <typename T = unsigned long long, typename OverflowPolicy = CheckedArithmetic>
+    static std::vector<T> generateFibonacci(unsigned int n) {
+        TraceSpan span("FibonacciGenerator::generateFibonacci");
+        if constexpr (std::is_same<OverflowPolicy, WrappingArithmetic>::value) {
+            return generateFibonacciWrapping<T>(n);
+        } else {
+            return FibonacciRecurrence<T, OverflowPolicy>({0, 1}).generate(n);
+        }
+    }
+    
+    /**
+     * Вычисляет n-е число Фибоначчи произвольной длины быстрым удвоением.
+     * На каждом шаге по паре (F(k-1), F(k)) получаем F(2k-1), F(2k), F(2k+1)
+     * всего двумя возведениями в квадрат:
+     *   F(2k+1) = 4F(k)^2 - F(k-1)^2 + 2(-1)^k
+     *   F(2k-1) = F(k)^2 + F(k-1)^2
+     *   F(2k)   = F(2k+1) - F(2k-1)
+     * Стоимость определяется последним умножением, которое для огромных n
+     * выполняется через NTT
+     * 
+     * @param n Номер числа Фибоначчи (F(0) = 0, F(1) = 1)
+     * @return F(n)
+     */
+    static BigNatural fibonacciBig(unsigned long long n) {
+        if (n == 0) {
+            return BigNatural();
+        }
+        
+        // Текущая пара (F(k-1), F(k)), начинаем с k = 1
+        BigNatural previous(0);
+        BigNatural current(1);
+        unsigned long long k = 1;
+        
+        int bit = 63 - __builtin_clzll(n);
+        while (--bit >= 0) {
+            BigNatural currentSquare = current * current;
+            BigNatural previousSquare = previous * previous;
+            
+            BigNatural next = currentSquare * 4 - previousSquare;
+            next = (k % 2 == 0) ? next + BigNatural(2) : next - BigNatural(2);
+            BigNatural before = currentSquare + previousSquare;
+            BigNatural middle = next - before;
+            
+            if ((n >> bit) & 1) {
+                previous = std::move(middle);
+                current = std::move(next);
+                k = 2 * k + 1;
+            } else {
+                previous = std::move(before);
+                current = std::move(middle);
+                k = 2 * k;
+            }
+        }
+        
+        return current;
+    }
+    
+    /**
+     * Проверяет, является ли число числом Фибоначчи.
+     * Без ветвлений: длина числа в битах выбирает ячейку таблицы,
+     * и значение сравнивается с обоими ее слотами
+     * 
+     * @param value Проверяемое число
+     * @return true, если value - число Фибоначчи
+     */
+    static bool isFibonacci(uint64_t value) {
+        unsigned bucket = 63 - __builtin_clzll(value | 1);
+        return (kFibonacciByBitLength[2 * bucket] == value) | (kFibonacciByBitLength[2 * bucket + 1] == value);
+    }
+    
+    /**
+     * Пакетная проверка массива чисел. На процессорах с AVX-512 (F и CD) числа
+     * проверяются по восемь за шаг, см. isFibonacciBatchAvx512; иначе по одному
+     * 
+     * @param values Проверяемые числа
+     * @param count Количество чисел
+     * @param result Массив из count элементов: 1, если число - число Фибоначчи, иначе 0
+     */
+    static void isFibonacciBatch(const uint64_t* values, size_t count, uint8_t* result) {
+#ifdef FIBONACCI_HAS_AVX512_BATCH
+        if (hasAvx512Batch()) {
+            isFibonacciBatchAvx512(values, count, result);
+            return;
+        }
+#endif
+        isFibonacciBatchScalar(values, count, result);
+    }
+    
+    /**
+     * Проверяет, является ли число произвольной длины числом Фибоначчи:
+     * n - число Фибоначчи тогда и только тогда, когда 5n^2 + 4 или 5n^2 - 4
+     * является точным квадратом
+     * 
+     * @param value Проверяемое число
+     * @return true, если value - число Фибоначчи
+     */
+    static bool isFibonacci(const BigNatural& value) {
+        BigNatural fiveSquares = value * value * 5u;
+        if (BigNatural::isPerfectSquare(fiveSquares + BigNatural(4))) {
+            return true;
+        }
+        return !(fiveSquares < BigNatural(4)) && BigNatural::isPerfectSquare(fiveSquares - BigNatural(4));
+    }
+};
@@ -0,0 +1,194 @@
+// fibonacci_cache.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "big_natural.h"
+#include "linear_recurrence.h"
+
+/**
+ * Общий для всего процесса кэш префикса последовательности Фибоначчи,
+ * который лениво достраивается по запросам.
+ *
+ * Числа хранятся в сегментах, размер которых удваивается: сегмент s вмещает
+ * kFirstSegmentSize * 2^s чисел. Сегменты никогда не перемещаются и
+ * не освобождаются, поэтому ссылки на уже вычисленные числа остаются
+ * действительными, а сами числа не копируются и не пересчитываются.
+ *
+ * Читатели не берут блокировку: опубликованная длина читается с acquire,
+ * и все числа до нее гарантированно записаны. Достраивает кэш только один
+ * писатель под мьютексом, публикуя новую длину с release
+ *
+ * @tparam T unsigned long long (до F(93) включительно) или BigNatural (без ограничения)
+ */
+template <typename T>
+class FibonacciCache {
+public:
+    static constexpr size_t kFirstSegmentSize = 64;
+
+    /**
+     * Представление первых size() чисел только для чтения
+     */
+    class View {
+    private:
+        const FibonacciCache* cache_;
+        size_t size_;
+
+    public:
+        View(const FibonacciCache* cache, size_t size) : cache_(cache), size_(size) {}
+
+        /**
+         * Число F(index) без проверки границ
+         */
+        const T& operator[](size_t index) const {
+            return cache_->element(index);
+        }
+
+        /**
+         * Число F(index)
+         *
+         * @throws std::out_of_range если index >= size()
+         */
+        [[nodiscard]] const T& at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Индекс за пределами представления");
+            }
+            return cache_->element(index);
+        }
+
+        [[nodiscard]] size_t size() const {
+            return size_;
+        }
+
+        /**
+         * Копия чисел в вектор
+         */
+        [[nodiscard]] std::vector<T> toVector() const {
+            std::vector<T> result;
+            result.reserve(size_);
+            for (size_t i = 0; i < size_; ++i) {
+                result.push_back(cache_->element(i));
+            }
+            return result;
+        }
+    };
+
+private:
+    // Сегментов хватает на kFirstSegmentSize * (2^48 - 1) чисел
+    static constexpr size_t kMaxSegments = 48;
+
+    std::atomic<T*> segments_[kMaxSegments];
+    std::atomic<size_t> size_;
+    std::mutex writerMutex_;
+
+    static size_t segmentOf(size_t index) {
+        return 63 - __builtin_clzll(index / kFirstSegmentSize + 1);
+    }
+
+    static size_t segmentStart(size_t segment) {
+        return kFirstSegmentSize * ((size_t(1) << segment) - 1);
+    }
+
+    const T& element(size_t index) const {
+        size_t segment = segmentOf(index);
+        return segments_[segment].load(std::memory_order_relaxed)[index - segmentStart(segment)];
+    }
+
+    T& writableElement(size_t index) {
+        size_t segment = segmentOf(index);
+        T* data = segments_[segment].load(std::memory_order_relaxed);
+        if (!data) {
+            data = new T[kFirstSegmentSize << segment]();
+            segments_[segment].store(data, std::memory_order_relaxed);
+        }
+        return data[index - segmentStart(segment)];
+    }
+
+    static T sum(const T& a, const T& b) {
+        if constexpr (std::is_integral<T>::value) {
+            return CheckedArithmetic::add(a, b);
+        } else {
+            return a + b;
+        }
+    }
+
+    /**
+     * Достраивание до n чисел; вызывается только под writerMutex_
+     */
+    void extend(size_t n) {
+        size_t size = size_.load(std::memory_order_relaxed);
+        for (size_t i = size; i < n; ++i) {
+            writableElement(i) = i < 2 ? T(i) : sum(element(i - 1), element(i - 2));
+        }
+        // Публикация: все записи выше становятся видны читателю, прочитавшему новую длину
+        size_.store(n, std::memory_order_release);
+    }
+
+public:
+    FibonacciCache() : size_(0) {
+        for (auto& segment : segments_) {
+            segment.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    FibonacciCache(const FibonacciCache&) = delete;
+    FibonacciCache& operator=(const FibonacciCache&) = delete;
+
+    ~FibonacciCache() {
+        for (auto& segment : segments_) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Единственный экземпляр кэша для процесса
+     */
+    static FibonacciCache& instance() {
+        static FibonacciCache cache;
+        return cache;
+    }
+
+    /**
+     * Первые n чисел Фибоначчи. Если они уже вычислены, вызов не блокируется
+     * и не выделяет память; иначе кэш достраивается одним писателем
+     *
+     * @param n Количество чисел
+     * @return Представление, действительное все время жизни кэша
+     * @throws std::invalid_argument если n равно 0
+     * @throws std::overflow_error если F(n - 1) не помещается в T
+     */
+    View prefix(size_t n) {
+        if (n == 0) {
+            throw std::invalid_argument("Количество чисел должно быть больше 0");
+        }
+        if (n > size_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(writerMutex_);
+            // Пока ждали мьютекс, кэш мог достроить другой поток
+            if (n > size_.load(std::memory_order_relaxed)) {
+                extend(n);
+            }
+        }
+        return View(this, n);
+    }
+
+    /**
+     * Число F(index), при необходимости с достраиванием кэша
+     *
+     * @throws std::overflow_error если F(index) не помещается в T
+     */
+    const T& operator[](size_t index) {
+        return prefix(index + 1)[index];
+    }
+
+    /**
+     * Количество уже вычисленных чисел
+     */
+    [[nodiscard]] size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+};
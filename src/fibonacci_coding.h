@@ -0,0 +1,208 @@
+// fibonacci_coding.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "fibonacci.h"
+
+/**
+ * Упакованный битовый поток: биты идут от младшего к старшему внутри слова
+ */
+struct FibonacciBitStream {
+    std::vector<uint64_t> words;
+    size_t bitCount = 0;
+};
+
+/**
+ * Фибоначчиево кодирование (универсальный код на основе представления Цекендорфа).
+ *
+ * Число v >= 1 записывается как сумма несоседних чисел Фибоначчи F(2), F(3), ...;
+ * бит j кода соответствует F(j + 2), биты пишутся от младшего числа к старшему,
+ * а за старшим битом ставится дополнительная единица. Так как в представлении
+ * Цекендорфа нет двух единиц подряд, пара "11" однозначно завершает код.
+ * Малые числа получают короткие коды: 1 -> "11", 2 -> "011", 3 -> "0011"
+ */
+class FibonacciCoder {
+public:
+    // Самый длинный код: 92 бита представления (F(2)..F(93)) и завершающая единица
+    static constexpr size_t kMaxCodeLength = 93;
+
+private:
+    /**
+     * Таблица F(0)..F(93) - все числа Фибоначчи, помещающиеся в uint64_t
+     */
+    static const std::vector<unsigned long long>& table() {
+        static const std::vector<unsigned long long> fibonacci = FibonacciGenerator::generateFibonacci(94);
+        return fibonacci;
+    }
+
+    /**
+     * Чтение 64 бит потока начиная с позиции position; биты за концом потока равны 0
+     */
+    static uint64_t readWord(const FibonacciBitStream& stream, size_t position) {
+        size_t index = position >> 6;
+        unsigned shift = position & 63;
+        if (index >= stream.words.size()) {
+            return 0;
+        }
+        uint64_t result = stream.words[index] >> shift;
+        if (shift != 0 && index + 1 < stream.words.size()) {
+            result |= stream.words[index + 1] << (64 - shift);
+        }
+        return result;
+    }
+
+    /**
+     * Сумма чисел Фибоначчи для установленных битов bits, начиная с F(firstIndex)
+     */
+    static uint64_t sumOfBits(const unsigned long long* fibonacci, uint64_t bits, size_t firstIndex) {
+        uint64_t value = 0;
+        while (bits) {
+            value += fibonacci[firstIndex + __builtin_ctzll(bits)];
+            bits &= bits - 1;
+        }
+        return value;
+    }
+
+    static void appendBits(FibonacciBitStream& stream, uint64_t bits, size_t length) {
+        if (length == 0) {
+            return;
+        }
+        size_t index = stream.bitCount >> 6;
+        unsigned shift = stream.bitCount & 63;
+        if (index >= stream.words.size()) {
+            stream.words.push_back(0);
+        }
+        stream.words[index] |= bits << shift;
+        if (shift + length > 64) {
+            stream.words.push_back(bits >> (64 - shift));
+        }
+        stream.bitCount += length;
+    }
+
+public:
+    /**
+     * Кодирование массива чисел в упакованный битовый поток
+     *
+     * @param values Числа для кодирования, каждое не меньше 1
+     * @param count Количество чисел
+     * @return Битовый поток с кодами всех чисел подряд
+     * @throws std::invalid_argument если среди чисел есть 0
+     */
+    static FibonacciBitStream encode(const uint64_t* values, size_t count) {
+        const auto& fibonacci = table();
+        FibonacciBitStream stream;
+        // Оценка сверху для малых чисел, поток дорастет при необходимости
+        stream.words.reserve(count / 8 + 2);
+
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t value = values[i];
+            if (value == 0) {
+                throw std::invalid_argument("Фибоначчиев код определен только для чисел больше 0");
+            }
+
+            // Старшее число Фибоначчи, не превосходящее value
+            size_t top = std::upper_bound(fibonacci.begin() + 2, fibonacci.end(), value) - fibonacci.begin() - 1;
+
+            // Жадно собираем представление Цекендорфа в 128-битный код без ветвлений:
+            // после вычитания F(k) остаток всегда меньше F(k - 1), поэтому соседние
+            // числа Фибоначчи сами собой не попадают в представление
+            unsigned __int128 code = static_cast<unsigned __int128>(1) << (top - 1);
+            uint64_t rest = value;
+            for (size_t k = top; k >= 2; --k) {
+                uint64_t take = fibonacci[k] <= rest;
+                rest -= take * fibonacci[k];
+                code |= static_cast<unsigned __int128>(take) << (k - 2);
+            }
+
+            size_t length = top;
+            uint64_t low = static_cast<uint64_t>(code);
+            uint64_t high = static_cast<uint64_t>(code >> 64);
+
+            appendBits(stream, low, std::min<size_t>(length, 64));
+            if (length > 64) {
+                appendBits(stream, high, length - 64);
+            }
+        }
+
+        return stream;
+    }
+
+    /**
+     * Декодирование потока в заранее выделенный массив.
+     * Конец каждого кода ищется сразу в 64-битном окне: w & (w >> 1) отмечает
+     * все пары соседних единиц, и первая из них - завершающая пара кода
+     *
+     * @param stream Поток, полученный из encode
+     * @param out Массив для результатов
+     * @param capacity Размер массива out
+     * @return Количество декодированных чисел
+     * @throws std::runtime_error если поток обрывается посреди кода
+     */
+    static size_t decode(const FibonacciBitStream& stream, uint64_t* out, size_t capacity) {
+        const unsigned long long* fibonacci = table().data();
+        size_t position = 0;
+        size_t decoded = 0;
+
+        while (position < stream.bitCount && decoded < capacity) {
+            uint64_t window = readWord(stream, position);
+            uint64_t pairs = window & (window >> 1) & 0x7FFFFFFFFFFFFFFFULL;
+
+            if (pairs) {
+                // Быстрый путь: код целиком помещается в окно
+                unsigned last = __builtin_ctzll(pairs);
+                uint64_t bits = window & ((2ULL << last) - 1);
+                out[decoded++] = sumOfBits(fibonacci, bits, 2);
+                position += last + 2;
+                continue;
+            }
+
+            // Длинный код (больше 64 бит): ищем пару на стыке и во втором окне
+            uint64_t next = readWord(stream, position + 64);
+            uint64_t crossing = (window >> 63) & next & 1;
+            uint64_t nextPairs = next & (next >> 1);
+            size_t last;
+            if (crossing) {
+                last = 63;
+            } else if (nextPairs) {
+                last = 64 + __builtin_ctzll(nextPairs);
+            } else {
+                throw std::runtime_error("Поврежденный поток: не найден конец фибоначчиева кода");
+            }
+
+            if (position + last + 2 > stream.bitCount) {
+                throw std::runtime_error("Поврежденный поток: код выходит за конец потока");
+            }
+
+            uint64_t value = sumOfBits(fibonacci, window & (last >= 64 ? ~0ULL : ((2ULL << last) - 1)), 2);
+            if (last >= 64) {
+                size_t highBits = last - 63;
+                value += sumOfBits(fibonacci, next & ((1ULL << highBits) - 1), 66);
+            }
+            out[decoded++] = value;
+            position += last + 2;
+        }
+
+        if (position > stream.bitCount) {
+            throw std::runtime_error("Поврежденный поток: код выходит за конец потока");
+        }
+
+        return decoded;
+    }
+
+    /**
+     * Декодирование всего потока
+     *
+     * @throws std::runtime_error если поток обрывается посреди кода
+     */
+    static std::vector<uint64_t> decode(const FibonacciBitStream& stream) {
+        // Самый короткий код - 2 бита, поэтому чисел не больше bitCount / 2
+        std::vector<uint64_t> values(stream.bitCount / 2);
+        values.resize(decode(stream, values.data(), values.size()));
+        return values;
+    }
+};
@@ -0,0 +1,282 @@
+// linear_recurrence.h
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Политики арифметики для LinearRecurrence.
+ * Каждая политика задает сложение и умножение для любого целого типа T
+ */
+
+/**
+ * Проверка переполнения: при выходе за пределы T бросается std::overflow_error
+ */
+struct CheckedArithmetic {
+    template <typename T>
+    static T add(T a, T b) {
+        T result;
+        if (__builtin_add_overflow(a, b, &result)) {
+            throw std::overflow_error("Переполнение при вычислении члена последовательности");
+        }
+        return result;
+    }
+
+    template <typename T>
+    static T multiply(T a, T b) {
+        T result;
+        if (__builtin_mul_overflow(a, b, &result)) {
+            throw std::overflow_error("Переполнение при вычислении члена последовательности");
+        }
+        return result;
+    }
+};
+
+/**
+ * Насыщение: при переполнении результат равен максимальному значению T
+ */
+struct SaturatingArithmetic {
+    template <typename T>
+    static T add(T a, T b) {
+        T result;
+        return __builtin_add_overflow(a, b, &result) ? maxValue<T>() : result;
+    }
+
+    template <typename T>
+    static T multiply(T a, T b) {
+        T result;
+        return __builtin_mul_overflow(a, b, &result) ? maxValue<T>() : result;
+    }
+
+private:
+    // numeric_limits не специализирован для __int128 в строгом режиме стандарта
+    template <typename T>
+    static constexpr T maxValue() {
+        static_assert(T(-1) > T(0), "Насыщение реализовано только для беззнаковых типов");
+        return T(-1);
+    }
+};
+
+/**
+ * Арифметика по модулю 2^(разрядность T) без проверок; T должен быть беззнаковым
+ */
+struct WrappingArithmetic {
+    template <typename T>
+    static T add(T a, T b) {
+        static_assert(T(-1) > T(0), "Циклическая арифметика определена только для беззнаковых типов");
+        return a + b;
+    }
+
+    template <typename T>
+    static T multiply(T a, T b) {
+        static_assert(T(-1) > T(0), "Циклическая арифметика определена только для беззнаковых типов");
+        return a * b;
+    }
+};
+
+/**
+ * Арифметика по модулю Modulus; значения должны быть меньше Modulus
+ */
+template <uint64_t Modulus>
+struct ModularArithmetic {
+    static_assert(Modulus > 0, "Модуль должен быть больше 0");
+
+    template <typename T>
+    static T add(T a, T b) {
+        return static_cast<T>((static_cast<unsigned __int128>(a) + b) % Modulus);
+    }
+
+    template <typename T>
+    static T multiply(T a, T b) {
+        return static_cast<T>(static_cast<unsigned __int128>(a) * b % Modulus);
+    }
+};
+
+/**
+ * Линейная рекуррентная последовательность с постоянными коэффициентами
+ *   a(n) = c1 * a(n-1) + c2 * a(n-2) + ... + ck * a(n-k)
+ *
+ * Коэффициенты - параметры шаблона, поэтому шаг последовательности
+ * разворачивается при компиляции: коэффициент 1 не дает умножения,
+ * коэффициент 0 выпадает из суммы. Начальные члены a(0) .. a(k-1)
+ * задаются в конструкторе.
+ *
+ * Примеры: Фибоначчи - <T, P, 1, 1> с {0, 1}, Люка - <T, P, 1, 1> с {2, 1},
+ * Пелль - <T, P, 2, 1> с {0, 1}, трибоначчи - <T, P, 1, 1, 1> с {0, 0, 1}
+ *
+ * @tparam T Тип членов последовательности
+ * @tparam Policy Политика арифметики: CheckedArithmetic, SaturatingArithmetic,
+ *                WrappingArithmetic, ModularArithmetic<M>
+ * @tparam Coefficients Коэффициенты c1 .. ck
+ */
+template <typename T, typename Policy, T... Coefficients>
+class LinearRecurrence {
+public:
+    static constexpr size_t kOrder = sizeof...(Coefficients);
+    static_assert(kOrder > 0, "Рекуррентность должна иметь хотя бы один коэффициент");
+
+    using Polynomial = std::array<T, kOrder>;
+
+private:
+    static constexpr std::array<T, kOrder> kCoefficients = {Coefficients...};
+
+    Polynomial initial_;
+
+    template <T Coefficient>
+    static T scale(T value) {
+        if constexpr (Coefficient == 0) {
+            return T(0);
+        } else if constexpr (Coefficient == 1) {
+            return value;
+        } else {
+            return Policy::multiply(Coefficient, value);
+        }
+    }
+
+    /**
+     * Следующий член по k предыдущим: previous[0] = a(n-k), ..., previous[k-1] = a(n-1)
+     */
+    template <size_t... Indices>
+    static T step(const T* previous, std::index_sequence<Indices...>) {
+        T next = T(0);
+        ((next = Policy::add(next, scale<Coefficients>(previous[kOrder - 1 - Indices]))), ...);
+        return next;
+    }
+
+    /**
+     * Произведение многочленов степени меньше k по модулю
+     * характеристического многочлена x^k - c1 x^(k-1) - ... - ck
+     */
+    static Polynomial multiplyModulo(const Polynomial& a, const Polynomial& b) {
+        std::array<T, 2 * kOrder - 1> product{};
+        for (size_t i = 0; i < kOrder; ++i) {
+            for (size_t j = 0; j < kOrder; ++j) {
+                product[i + j] = Policy::add(product[i + j], Policy::multiply(a[i], b[j]));
+            }
+        }
+        reduce(product);
+
+        Polynomial result;
+        std::copy(product.begin(), product.begin() + kOrder, result.begin());
+        return result;
+    }
+
+    /**
+     * Умножение на x по модулю характеристического многочлена
+     */
+    static Polynomial multiplyByX(const Polynomial& a) {
+        std::array<T, kOrder + 1> product{};
+        std::copy(a.begin(), a.end(), product.begin() + 1);
+        reduce(product);
+
+        Polynomial result;
+        std::copy(product.begin(), product.begin() + kOrder, result.begin());
+        return result;
+    }
+
+    /**
+     * Понижение степени: x^k заменяется на c1 x^(k-1) + ... + ck
+     */
+    template <size_t Size>
+    static void reduce(std::array<T, Size>& product) {
+        for (size_t degree = Size - 1; degree >= kOrder; --degree) {
+            T top = product[degree];
+            if (top == T(0)) {
+                continue;
+            }
+            for (size_t j = 0; j < kOrder; ++j) {
+                T& target = product[degree - 1 - j];
+                target = Policy::add(target, Policy::multiply(kCoefficients[j], top));
+            }
+        }
+    }
+
+public:
+    /**
+     * @param initial Начальные члены a(0) .. a(k-1)
+     */
+    explicit LinearRecurrence(const Polynomial& initial) : initial_(initial) {}
+
+    /**
+     * Первые n членов последовательности
+     *
+     * @param n Количество членов
+     * @return Вектор a(0) .. a(n-1)
+     * @throws std::invalid_argument если n равно 0
+     * @throws std::overflow_error при переполнении (для CheckedArithmetic)
+     */
+    [[nodiscard]] std::vector<T> generate(size_t n) const {
+        if (n == 0) {
+            throw std::invalid_argument("Количество чисел должно быть больше 0");
+        }
+
+        std::vector<T> values(n);
+        size_t prefix = std::min(n, kOrder);
+        std::copy(initial_.begin(), initial_.begin() + prefix, values.begin());
+        for (size_t i = kOrder; i < n; ++i) {
+            values[i] = step(values.data() + i - kOrder, std::make_index_sequence<kOrder>());
+        }
+        return values;
+    }
+
+    /**
+     * n-й член методом Китамасы за O(k^2 log n): вычисляется x^n по модулю
+     * характеристического многочлена, и a(n) = сумма d_i * a(i) по его коэффициентам.
+     * Для CheckedArithmetic промежуточные значения могут переполниться
+     * немного раньше, чем сам член
+     *
+     * @param n Номер члена (с нуля)
+     * @throws std::overflow_error при переполнении (для CheckedArithmetic)
+     */
+    [[nodiscard]] T term(unsigned long long n) const {
+        if (n < kOrder) {
+            return initial_[n];
+        }
+
+        // Многочлен x^n mod f(x), биты n читаются от старшего к младшему
+        Polynomial power{};
+        power[0] = T(1);
+        for (int bit = 63 - __builtin_clzll(n); bit >= 0; --bit) {
+            power = multiplyModulo(power, power);
+            if ((n >> bit) & 1) {
+                power = multiplyByX(power);
+            }
+        }
+
+        T result = T(0);
+        for (size_t i = 0; i < kOrder; ++i) {
+            result = Policy::add(result, Policy::multiply(power[i], initial_[i]));
+        }
+        return result;
+    }
+
+    /**
+     * Начальные члены последовательности
+     */
+    [[nodiscard]] const Polynomial& initial() const {
+        return initial_;
+    }
+};
+
+/**
+ * Рекуррентность Фибоначчи и Люка: a(n) = a(n-1) + a(n-2)
+ */
+template <typename T = unsigned long long, typename Policy = CheckedArithmetic>
+using FibonacciRecurrence = LinearRecurrence<T, Policy, 1, 1>;
+
+/**
+ * Рекуррентность Пелля: a(n) = 2a(n-1) + a(n-2)
+ */
+template <typename T = unsigned long long, typename Policy = CheckedArithmetic>
+using PellRecurrence = LinearRecurrence<T, Policy, 2, 1>;
+
+/**
+ * Рекуррентность трибоначчи: a(n) = a(n-1) + a(n-2) + a(n-3)
+ */
+template <typename T = unsigned long long, typename Policy = CheckedArithmetic>
+using TribonacciRecurrence = LinearRecurrence<T, Policy, 1, 1, 1>;
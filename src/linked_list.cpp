@@ -1,160 +1,3 @@
-// linked_list.h
-#pragma once
-
-#include <memory>
-#include <stdexcept>
-#include <iostream>
-#include <vector>
-
-template <typename T>
-class LinkedList {
-public:
-    struct Node {
-        T data;
-        std::shared_ptr<Node> next;
-        
-        explicit Node(T value) : data(std::move(value)), next(nullptr) {}
-    };
-    
-private:
-    std::shared_ptr<Node> head_;
-    size_t size_;
-    
-public:
-    LinkedList() : head_(nullptr), size_(0) {}
-    
-    /**
-     * Создание списка из вектора значений
-     */
-    explicit LinkedList(const std::vector<T>& values) : head_(nullptr), size_(0) {
-        for (const auto& value : values) {
-            pushBack(value);
-        }
-    }
-    
-    /**
-     * Добавление элемента в конец списка
-     */
-    void pushBack(T value) {
-        auto newNode = std::make_shared<Node>(std::move(value));
-        
-        if (!head_) {
-            head_ = newNode;
-        } else {
-            auto current = head_;
-            while (current->next) {
-                current = current->next;
-            }
-            current->next = newNode;
-        }
-        
-        ++size_;
-    }
-    
-    /**
-     * Добавление элемента в начало списка
-     */
-    void pushFront(T value) {
-        auto newNode = std::make_shared<Node>(std::move(value));
-        newNode->next = head_;
-        head_ = newNode;
-        ++size_;
-    }
-    
-    /**
-     * Получение размера списка
-     */
-    [[nodiscard]] size_t size() const {
-        return size_;
-    }
-    
-    /**
-     * Проверка пустой ли список
-     */
-    [[nodiscard]] bool isEmpty() const {
-        return size_ == 0;
-    }
-    
-    /**
-     * Получение указателя на голову списка
-     */
-    [[nodiscard]] std::shared_ptr<Node> getHead() const {
-        return head_;
-    }
-    
-    /**
-     * Очистка списка
-     */
-    void clear() {
-        head_ = nullptr;
-        size_ = 0;
-    }
-    
-    /**
-     * Преобразование списка в вектор
-     */
-    [[nodiscard]] std::vector<T> toVector() const {
-        std::vector<T> result;
-        result.reserve(size_);
-        
-        auto current = head_;
-        while (current) {
-            result.push_back(current->data);
-            current = current->next;
-        }
-        
-        return result;
-    }
-    
-    /**
-     * Разворот связного списка (итеративный подход)
-     * Меняет текущий список и возвращает указатель на новую голову
-     */
-    std::shared_ptr<Node> reverse() {
-        if (!head_ || !head_->next) {
-            return head_; // Пустой список или список из одного элемента не требует разворота
-        }
-        
-        std::shared_ptr<Node> prev = nullptr;
-        std::shared_ptr<Node> current = head_;
-        std::shared_ptr<Node> next = nullptr;
-        
-        while (current) {
-            // Сохраняем следующий узел
-            next = current->next;
-            
-            // Меняем указатель текущего узла на предыдущий
-            current->next = prev;
-            
-            // Переходим к следующей итерации
-            prev = current;
-            current = next;
-        }
-        
-        // Обновляем голову списка
-        head_ = prev;
-        
-        return head_;
-    }
-    
-    /**
-     * Статический метод для разворота списка без изменения оригинального списка
-     * Возвращает новый развернутый список
-     */
-    static LinkedList<T> reverseCopy(const LinkedList<T>& list) {
-        LinkedList<T> result;
-        auto current = list.getHead();
-        
-        // Для каждого элемента в исходном списке добавляем его в начало нового списка
-        while (current) {
-            result.pushFront(current->data);
-            current = current->next;
-        }
-        
-        return result;
-    }
-};
-
 // linked_list_test.cpp
 #include <gtest/gtest.h>
 #include "linked_list.h"
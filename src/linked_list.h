@@ -0,0 +1,1402 @@
+// linked_list.h
+#pragma once
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
+#include <iterator>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <optional>
+#include <utility>
+
+#include "list_index.h"
+#include "mapped_file.h"
+#include "trace.h"
+
+/**
+ * Память, занятая структурой данных: сколько байтов запрошено у распределителя
+ * памяти. Служебные заголовки malloc зависят от платформы и не учитываются
+ */
+struct MemoryUsage {
+    // Сам объект, включая встроенные ячейки
+    size_t object = 0;
+    // Узлы в куче (вместе с управляющими блоками shared_ptr) и блоки арен
+    size_t nodes = 0;
+    // Память, которой владеют сами элементы (например, буферы длинных строк)
+    size_t payload = 0;
+    // Позиционный индекс
+    size_t index = 0;
+
+    [[nodiscard]] size_t total() const {
+        return object + nodes + payload + index;
+    }
+
+    /**
+     * Память в куче, которой владеет элемент. Короткие строки хранятся
+     * внутри объекта строки и памяти в куче не занимают
+     */
+    template <typename T>
+    static size_t payloadBytes(const T& value) {
+        if constexpr (std::is_same<T, std::string>::value) {
+            const char* self = reinterpret_cast<const char*>(&value);
+            bool local = std::less_equal<const char*>()(self, value.data()) &&
+                         std::less<const char*>()(value.data(), self + sizeof(value));
+            return local ? 0 : value.capacity() + 1;
+        } else {
+            (void)value;
+            return 0;
+        }
+    }
+};
+
+/**
+ * Арена для пакетного выделения узлов: память под все узлы берется
+ * одним блоком и освобождается целиком вместе с последним узлом
+ */
+class NodeArena {
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    char* cursor_;
+    size_t remaining_;
+    size_t capacityHint_;
+
+public:
+    // Следующая арена того же списка: список хранит свои арены цепочкой, чтобы учитывать их память
+    std::shared_ptr<NodeArena> next;
+
+    /**
+     * @param capacityHint Ожидаемое количество выделений
+     */
+    explicit NodeArena(size_t capacityHint)
+        : cursor_(nullptr), remaining_(0), capacityHint_(capacityHint > 0 ? capacityHint : 1) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    /**
+     * Выделение bytes байтов с выравниванием alignment
+     *
+     * @throws std::length_error если блок на capacityHint выделений не выражается в size_t
+     */
+    void* allocate(size_t bytes, size_t alignment) {
+        size_t padding = (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment;
+        if (!cursor_ || padding + bytes > remaining_) {
+            // Блок рассчитан сразу на все ожидаемые выделения. Размер объекта кратен
+            // его выравниванию, поэтому выравнивать приходится только первое выделение в блоке
+            if (bytes > 0 && capacityHint_ > (SIZE_MAX - alignment) / bytes) {
+                throw std::length_error("Слишком большой блок арены");
+            }
+            size_t blockSize = bytes * capacityHint_ + alignment;
+            blocks_.push_back(Block{std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+            cursor_ = blocks_.back().data.get();
+            remaining_ = blockSize;
+            padding = (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment;
+        }
+
+        char* result = cursor_ + padding;
+        cursor_ = result + bytes;
+        remaining_ -= padding + bytes;
+        return result;
+    }
+
+    /**
+     * Обход блоков арены как visit(начало, размер)
+     */
+    template <typename Visitor>
+    void forEachBlock(Visitor visit) const {
+        for (const auto& block : blocks_) {
+            visit(block.data.get(), block.size);
+        }
+    }
+
+    /**
+     * Память списка блоков (без самих блоков)
+     */
+    [[nodiscard]] size_t blockListBytes() const {
+        return blocks_.capacity() * sizeof(Block);
+    }
+};
+
+/**
+ * Аллокатор для std::allocate_shared поверх NodeArena.
+ * Каждый управляющий блок хранит копию аллокатора, поэтому арена
+ * живет, пока жив хотя бы один выделенный в ней узел
+ */
+template <typename U>
+class ArenaAllocator {
+public:
+    using value_type = U;
+
+    std::shared_ptr<NodeArena> arena;
+
+    explicit ArenaAllocator(std::shared_ptr<NodeArena> nodeArena) : arena(std::move(nodeArena)) {}
+
+    template <typename V>
+    ArenaAllocator(const ArenaAllocator<V>& other) : arena(other.arena) {}
+
+    U* allocate(size_t n) {
+        return static_cast<U*>(arena->allocate(n * sizeof(U), alignof(U)));
+    }
+
+    // Память возвращается только целиком при уничтожении арены
+    void deallocate(U*, size_t) noexcept {}
+
+    template <typename V>
+    bool operator==(const ArenaAllocator<V>& other) const {
+        return arena == other.arena;
+    }
+
+    template <typename V>
+    bool operator!=(const ArenaAllocator<V>& other) const {
+        return arena != other.arena;
+    }
+};
+
+// Размер последнего выделения CountingAllocator в этом потоке
+inline size_t& countedAllocationBytes() {
+    static thread_local size_t bytes = 0;
+    return bytes;
+}
+
+/**
+ * Аллокатор без состояния, который выделяет память через operator new
+ * и запоминает размер выделения в countedAllocationBytes(). Так узнается
+ * размер выделения std::allocate_shared вместе с управляющим блоком,
+ * тип которого снаружи недоступен
+ */
+template <typename U>
+class CountingAllocator {
+public:
+    using value_type = U;
+
+    CountingAllocator() = default;
+
+    template <typename V>
+    CountingAllocator(const CountingAllocator<V>&) {}
+
+    U* allocate(size_t n) {
+        countedAllocationBytes() = n * sizeof(U);
+        return static_cast<U*>(::operator new(n * sizeof(U)));
+    }
+
+    void deallocate(U* pointer, size_t) noexcept {
+        ::operator delete(pointer);
+    }
+
+    template <typename V>
+    bool operator==(const CountingAllocator<V>&) const {
+        return true;
+    }
+
+    template <typename V>
+    bool operator!=(const CountingAllocator<V>&) const {
+        return false;
+    }
+};
+
+template <typename T>
+class LinkedList {
+public:
+    struct Node {
+        T data;
+        std::shared_ptr<Node> next;
+        
+        explicit Node(T value) : data(std::move(value)), next(nullptr) {}
+    };
+    
+    // Число узлов, которые хранятся прямо в объекте списка (не больше 512 байт на все ячейки)
+    static constexpr size_t kInlineCapacity = std::min<size_t>(16, std::max<size_t>(1, 512 / sizeof(Node)));
+    
+private:
+    static_assert(kInlineCapacity <= 32, "Занятость встроенных ячеек хранится в 32-битной маске");
+    static constexpr uint32_t kInlineFull = (uint32_t(1) << (kInlineCapacity - 1) << 1) - 1;
+    
+    // mutable здесь и ниже: escape() переносит встроенные узлы в кучу и в константном
+    // getHead(), содержимое списка при этом не меняется
+    mutable std::shared_ptr<Node> head_;
+    size_t size_;
+    // Необязательный позиционный индекс, см. enableIndex()
+    std::unique_ptr<ListIndex<Node>> index_;
+    // Арены, из которых брались узлы списка (цепочка через NodeArena::next), см. memoryUsage()
+    std::shared_ptr<NodeArena> arenas_;
+    // Встроенные ячейки для узлов и маска занятых ячеек
+    alignas(Node) mutable unsigned char inlineStorage_[kInlineCapacity * sizeof(Node)];
+    mutable uint32_t inlineUsed_;
+    // Ссылки на узлы выданы наружу (см. escape()): новые узлы создаются только в куче
+    mutable bool escaped_;
+    
+    // Заголовок бинарного формата сериализации
+    struct BinaryHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t kind;
+        uint32_t elementSize;
+        uint64_t count;
+    };
+    
+    static constexpr char kBinaryMagic[4] = {'L', 'L', 'S', 'T'};
+    static constexpr uint32_t kBinaryVersion = 1;
+    static constexpr uint32_t kKindTrivial = 0;
+    static constexpr uint32_t kKindString = 1;
+    static constexpr size_t kWriteBlockSize = 1 << 16;
+    // Меньше стольких узлов на поток параллельное построение не окупает запуск потока
+    static constexpr size_t kBulkGrain = 1 << 15;
+    
+    /**
+     * Слияние двух отсортированных цепочек перестановкой указателей.
+     * При равенстве первым идет узел из left, что обеспечивает устойчивость
+     */
+    template <typename Compare>
+    static std::shared_ptr<Node> mergeChains(std::shared_ptr<Node> left, std::shared_ptr<Node> right,
+                                             Compare& comp) {
+        std::shared_ptr<Node> result;
+        std::shared_ptr<Node>* link = &result;
+        
+        while (left && right) {
+            std::shared_ptr<Node>& source = comp(right->data, left->data) ? right : left;
+            *link = std::move(source);
+            source = std::move((*link)->next);
+            link = &(*link)->next;
+        }
+        
+        *link = left ? std::move(left) : std::move(right);
+        return result;
+    }
+    
+    /**
+     * Разворот первых count узлов цепочки перестановкой указателей.
+     * Бывший первый узел становится последним в отрезке и подвешивается
+     * к остатку цепочки
+     *
+     * @return Новая голова цепочки
+     */
+    static std::shared_ptr<Node> reverseChain(std::shared_ptr<Node> chain, size_t count) {
+        Node* segmentTail = chain.get();
+        std::shared_ptr<Node> prev = nullptr;
+        std::shared_ptr<Node> current = std::move(chain);
+        
+        for (size_t i = 0; i < count; ++i) {
+            std::shared_ptr<Node> next = std::move(current->next);
+            current->next = std::move(prev);
+            prev = std::move(current);
+            current = std::move(next);
+        }
+        
+        segmentTail->next = std::move(current);
+        return prev;
+    }
+    
+    static constexpr bool isTriviallySerializable() {
+        return std::is_trivially_copyable<T>::value;
+    }
+    
+    static constexpr bool isStringSerializable() {
+        return std::is_same<T, std::string>::value;
+    }
+    
+    Node* inlineSlot(size_t slot) const {
+        return reinterpret_cast<Node*>(inlineStorage_ + slot * sizeof(Node));
+    }
+    
+    /**
+     * Можно ли взять для нового узла встроенную ячейку
+     */
+    bool hasFreeSlot() const {
+        return !escaped_ && inlineUsed_ != kInlineFull;
+    }
+    
+    /**
+     * Лежит ли узел во встроенных ячейках этого списка
+     */
+    bool isInline(const Node* node) const {
+        const Node* first = reinterpret_cast<const Node*>(inlineStorage_);
+        return std::less_equal<const Node*>()(first, node) && std::less<const Node*>()(node, first + kInlineCapacity);
+    }
+    
+    /**
+     * Новый узел: во встроенной ячейке, если есть свободная, иначе в куче.
+     * Ссылка на встроенный узел не владеет им (пустой управляющий блок),
+     * узлом владеет сам список; ссылки на узлы в куче владеют ими как раньше.
+     * Такие ссылки не выходят наружу: перед выдачей узлов вызывается escape()
+     */
+    template <typename Value>
+    std::shared_ptr<Node> createNode(Value&& value) {
+        if (!hasFreeSlot()) {
+            return std::make_shared<Node>(std::forward<Value>(value));
+        }
+        size_t slot = __builtin_ctz(~inlineUsed_);
+        Node* node = new (inlineSlot(slot)) Node(std::forward<Value>(value));
+        inlineUsed_ |= uint32_t(1) << slot;
+        return std::shared_ptr<Node>(std::shared_ptr<Node>(), node);
+    }
+    
+    /**
+     * Уничтожение встроенного узла; его ссылка next уже должна быть перенесена
+     */
+    void releaseSlot(Node* node) const {
+        size_t slot = static_cast<size_t>(node - inlineSlot(0));
+        node->~Node();
+        inlineUsed_ &= ~(uint32_t(1) << slot);
+    }
+    
+    /**
+     * Перенос встроенных узлов в кучу перед выдачей ссылок на узлы наружу
+     * (getHead(), reverse() и др.): ссылка на встроенный узел не владеет им
+     * и пережила бы список. Выданная цепочка может получить новые узлы
+     * (например, через pushBack), поэтому до очистки списка они создаются в куче
+     */
+    void escape() const {
+        if (inlineUsed_ != 0) {
+            try {
+                for (std::shared_ptr<Node>* link = &head_; *link && inlineUsed_ != 0; link = &(*link)->next) {
+                    Node* node = link->get();
+                    if (isInline(node)) {
+                        std::shared_ptr<Node> moved = std::make_shared<Node>(std::move(node->data));
+                        moved->next = std::move(node->next);
+                        releaseSlot(node);
+                        *link = std::move(moved);
+                    }
+                }
+            } catch (...) {
+                if (index_) {
+                    index_->relocate(head_.get());
+                }
+                throw;
+            }
+            if (index_) {
+                index_->relocate(head_.get());
+            }
+        }
+        escaped_ = true;
+    }
+    
+    /**
+     * Забирает цепочку узлов other. Встроенные узлы other живут внутри объекта other,
+     * поэтому их элементы переносятся в свободные ячейки этого списка (или в кучу,
+     * если ячеек не хватило); узлы в куче переходят без копирования
+     */
+    std::shared_ptr<Node> takeChain(LinkedList& other) {
+        std::shared_ptr<Node> chain = std::move(other.head_);
+        for (std::shared_ptr<Node>* link = &chain; *link && other.inlineUsed_ != 0; link = &(*link)->next) {
+            Node* node = link->get();
+            if (other.isInline(node)) {
+                std::shared_ptr<Node> moved = createNode(std::move(node->data));
+                moved->next = std::move(node->next);
+                other.releaseSlot(node);
+                *link = std::move(moved);
+            }
+        }
+        other.size_ = 0;
+        return chain;
+    }
+    
+    /**
+     * Перенос узлов, индекса и арен other в пустой список без выделения памяти:
+     * встроенные узлы other попадают в свободные встроенные ячейки этого списка,
+     * а башни индекса переводятся на их новые адреса, а не строятся заново
+     */
+    void takeFrom(LinkedList& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        bool movesInline = other.inlineUsed_ != 0;
+        size_ = other.size_;
+        head_ = takeChain(other);
+        index_ = std::move(other.index_);
+        arenas_ = std::move(other.arenas_);
+        if (index_ && movesInline) {
+            index_->relocate(head_.get());
+        }
+        // Ссылки на узлы other, выданные наружу, теперь ведут в этот список
+        escaped_ = other.escaped_;
+        other.escaped_ = false;
+    }
+    
+    /**
+     * Копирование элементов other в пустой список. Узлы копируются все:
+     * общий с other хвост мог бы после изменения other ссылаться на его встроенные ячейки
+     */
+    void copyFrom(const LinkedList& other) {
+        std::shared_ptr<Node>* link = &head_;
+        for (const Node* node = other.head_.get(); node; node = node->next.get()) {
+            *link = createNode(node->data);
+            link = &(*link)->next;
+        }
+        size_ = other.size_;
+    }
+    
+    /**
+     * Добавление цепочки арен chain к аренам списка
+     */
+    void adoptArenas(std::shared_ptr<NodeArena> chain) {
+        std::shared_ptr<NodeArena>* link = &arenas_;
+        while (*link) {
+            link = &(*link)->next;
+        }
+        *link = std::move(chain);
+    }
+    
+    /**
+     * Забываем арены, в которых не осталось узлов: на арену ссылается
+     * копия аллокатора в каждом ее узле, и единственная ссылка - ссылка списка
+     */
+    void pruneArenas() {
+        for (std::shared_ptr<NodeArena>* link = &arenas_; *link;) {
+            if (link->use_count() == 1) {
+                *link = std::move((*link)->next);
+            } else {
+                link = &(*link)->next;
+            }
+        }
+    }
+    
+    /**
+     * Размер выделения make_shared<U> вместе с управляющим блоком, считается один раз на тип.
+     * Выделяется заглушка того же размера и выравнивания, что U, поэтому элементы
+     * не создаются и не копируются. Пустой CountingAllocator, как и std::allocator
+     * в make_shared, не занимает места в управляющем блоке, и размеры совпадают
+     */
+    template <typename U>
+    static size_t sharedAllocationBytes() {
+        static const size_t bytes = [] {
+            struct alignas(U) Storage {
+                unsigned char data[sizeof(U)];
+            };
+            (void)std::allocate_shared<Storage>(CountingAllocator<Storage>());
+            return countedAllocationBytes();
+        }();
+        return bytes;
+    }
+    
+    /**
+     * Построение цепочки узлов в куче из count значений, начиная с first.
+     * Значения делятся на отрезки по потокам (не меньше kBulkGrain на поток),
+     * каждый поток берет память под свои узлы одним блоком NodeArena и связывает
+     * их по мере создания; затем отрезки сшиваются за число потоков шагов
+     *
+     * @param arenas Цепочка арен, к которой добавляются арены отрезков
+     * @return Голова цепочки
+     * @throws Первое исключение из конструктора элемента или выделения памяти
+     */
+    template <typename Iterator>
+    static std::shared_ptr<Node> buildChain(Iterator first, size_t count, std::shared_ptr<NodeArena>& arenas) {
+        size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        threads = std::min(threads, std::max<size_t>(1, count / kBulkGrain));
+        
+        struct Segment {
+            std::shared_ptr<Node> head;
+            Node* tail = nullptr;
+            std::shared_ptr<NodeArena> arena;
+            std::exception_ptr error;
+        };
+        std::vector<Segment> segments(threads);
+        
+        auto build = [first, count, threads, &segments](size_t part) {
+            size_t begin = count * part / threads;
+            size_t end = count * (part + 1) / threads;
+            Segment& segment = segments[part];
+            try {
+                segment.arena = std::make_shared<NodeArena>(end - begin);
+                ArenaAllocator<Node> allocator(segment.arena);
+                std::shared_ptr<Node>* link = &segment.head;
+                Iterator current = first + static_cast<typename std::iterator_traits<Iterator>::difference_type>(begin);
+                for (size_t i = begin; i < end; ++i, ++current) {
+                    *link = std::allocate_shared<Node>(allocator, *current);
+                    segment.tail = link->get();
+                    link = &segment.tail->next;
+                }
+            } catch (...) {
+                segment.error = std::current_exception();
+            }
+        };
+        
+        std::vector<std::thread> workers;
+        for (size_t part = 1; part < threads; ++part) {
+            try {
+                workers.emplace_back(build, part);
+            } catch (const std::system_error&) {
+                // Поток не запустился: отрезок строится в текущем потоке
+                build(part);
+            }
+        }
+        build(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        
+        std::shared_ptr<Node> chain;
+        std::exception_ptr error;
+        for (size_t part = threads; part-- > 0;) {
+            Segment& segment = segments[part];
+            if (segment.error) {
+                error = segment.error;
+            }
+            if (segment.head) {
+                segment.tail->next = std::move(chain);
+                chain = std::move(segment.head);
+            }
+        }
+        if (error) {
+            // Уже созданные узлы освобождаются итеративно деструктором списка
+            LinkedList garbage;
+            garbage.head_ = std::move(chain);
+            std::rethrow_exception(error);
+        }
+        for (Segment& segment : segments) {
+            if (segment.arena) {
+                segment.arena->next = std::move(arenas);
+                arenas = std::move(segment.arena);
+            }
+        }
+        return chain;
+    }
+    
+    /**
+     * Итеративное освобождение узлов: рекурсивные деструкторы shared_ptr
+     * переполняют стек на длинных списках. Узлы в куче, на которые ссылается
+     * кто-то еще (например, копия списка), не трогаем
+     */
+    void releaseNodes() {
+        for (;;) {
+            while (head_ && (isInline(head_.get()) || head_.use_count() == 1)) {
+                Node* node = head_.get();
+                std::shared_ptr<Node> next = std::move(node->next);
+                if (isInline(node)) {
+                    releaseSlot(node);
+                }
+                head_ = std::move(next);
+            }
+            head_ = nullptr;
+            if (inlineUsed_ == 0) {
+                break;
+            }
+            // Встроенные узлы за узлом, на который ссылается кто-то еще, живут только вместе
+            // со списком: освобождаем их и продолжаем с их хвоста
+            Node* node = inlineSlot(__builtin_ctz(inlineUsed_));
+            head_ = std::move(node->next);
+            releaseSlot(node);
+        }
+        arenas_ = nullptr;
+        // Выданные ссылки больше не связаны с узлами списка
+        escaped_ = false;
+    }
+    
+    /**
+     * Ссылка next последнего узла (или голова пустого списка): с индексом хвост находится за O(log n)
+     */
+    std::shared_ptr<Node>* tailLink() {
+        if (!head_) {
+            return &head_;
+        }
+        Node* tail = index_ ? index_->find(size_ - 1, head_.get()) : head_.get();
+        while (tail->next) {
+            tail = tail->next.get();
+        }
+        return &tail->next;
+    }
+    
+    /**
+     * Перестройка индекса после операций, переставляющих много узлов
+     */
+    void rebuildIndex() {
+        if (index_) {
+            index_->rebuild(head_.get());
+        }
+    }
+    
+    /**
+     * Узел с номером index: через индекс, если он включен, иначе проходом от головы
+     *
+     * @throws std::out_of_range если index >= size()
+     */
+    Node* nodeAt(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Индекс за пределами списка");
+        }
+        if (index_) {
+            return index_->find(index, head_.get());
+        }
+        Node* node = head_.get();
+        for (size_t i = 0; i < index; ++i) {
+            node = node->next.get();
+        }
+        return node;
+    }
+    
+public:
+    LinkedList() : head_(nullptr), size_(0), inlineUsed_(0), escaped_(false) {}
+    
+    /**
+     * Копия не разделяет узлы с оригиналом: первые kInlineCapacity элементов попадают
+     * во встроенные ячейки копии. Индекс строится заново, если он был у оригинала
+     */
+    LinkedList(const LinkedList& other) : head_(nullptr), size_(0), inlineUsed_(0), escaped_(false) {
+        // Деструктор недостроенного объекта не вызывается: уже созданные узлы освобождаем сами
+        try {
+            copyFrom(other);
+            if (other.index_) {
+                enableIndex();
+            }
+        } catch (...) {
+            releaseNodes();
+            throw;
+        }
+    }
+    
+    /**
+     * Перемещение не выделяет память: узлы в куче переходят как есть,
+     * элементы встроенных узлов переносятся в ячейки нового объекта, см. takeFrom()
+     */
+    LinkedList(LinkedList&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : head_(nullptr), size_(0), inlineUsed_(0), escaped_(false) {
+        takeFrom(other);
+    }
+    
+    /**
+     * Копия строится отдельно и затем перемещается в список, поэтому исключение
+     * при копировании элемента оставляет список без изменений
+     */
+    LinkedList& operator=(const LinkedList& other) {
+        if (this != &other) {
+            LinkedList copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    
+    LinkedList& operator=(LinkedList&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            releaseNodes();
+            takeFrom(other);
+        }
+        return *this;
+    }
+    
+    ~LinkedList() {
+        releaseNodes();
+    }
+    
+    /**
+     * Создание списка из вектора значений за один проход, см. append()
+     */
+    explicit LinkedList(const std::vector<T>& values) : head_(nullptr), size_(0), inlineUsed_(0), escaped_(false) {
+        append(values.begin(), values.end());
+    }
+    
+    /**
+     * Добавление элементов [first, last) в конец списка за один проход.
+     * Сначала заполняются свободные встроенные ячейки, остальные узлы строятся
+     * пакетом: память берется одним блоком на поток, элементы больших диапазонов
+     * копируются в нескольких потоках (см. buildChain). Индекс перестраивается
+     *
+     * @param first Начало диапазона (итератор произвольного доступа)
+     * @param last Конец диапазона
+     * @throws Исключение конструктора элемента; уже добавленные во встроенные
+     *         ячейки элементы остаются в списке
+     */
+    template <typename Iterator>
+    void append(Iterator first, Iterator last) {
+        static_assert(std::is_base_of<std::random_access_iterator_tag,
+                                      typename std::iterator_traits<Iterator>::iterator_category>::value,
+                      "Пакетное добавление требует итераторов произвольного доступа");
+        TraceSpan span("LinkedList::append");
+        size_t count = static_cast<size_t>(last - first);
+        if (count == 0) {
+            return;
+        }
+        
+        std::shared_ptr<Node>* link = tailLink();
+        try {
+            for (; first != last && hasFreeSlot(); ++first) {
+                *link = createNode(*first);
+                link = &(*link)->next;
+                ++size_;
+            }
+            if (first != last) {
+                size_t rest = static_cast<size_t>(last - first);
+                *link = buildChain(first, rest, arenas_);
+                size_ += rest;
+            }
+        } catch (...) {
+            rebuildIndex();
+            throw;
+        }
+        rebuildIndex();
+    }
+    
+    void append(const std::vector<T>& values) {
+        append(values.begin(), values.end());
+    }
+    
+    /**
+     * Добавление в конец списка элементов, которые выдает producer, когда их
+     * число заранее неизвестно. Сначала заполняются свободные встроенные ячейки,
+     * остальные узлы берутся из NodeArena блоками по expectedCount узлов
+     *
+     * @param expectedCount Ожидаемое число элементов (размер блока арены)
+     * @param producer Вызывается один раз как producer(emit), emit(value) добавляет элемент
+     */
+    template <typename Producer>
+    void appendStream(size_t expectedCount, Producer producer) {
+        TraceSpan span("LinkedList::appendStream");
+        std::shared_ptr<Node>* link = tailLink();
+        std::optional<ArenaAllocator<Node>> allocator;
+        
+        try {
+            producer([&](auto&& value) {
+                if (hasFreeSlot()) {
+                    *link = createNode(std::forward<decltype(value)>(value));
+                } else {
+                    if (!allocator) {
+                        auto arena = std::make_shared<NodeArena>(expectedCount);
+                        allocator.emplace(arena);
+                        arena->next = std::move(arenas_);
+                        arenas_ = std::move(arena);
+                    }
+                    *link = std::allocate_shared<Node>(*allocator, std::forward<decltype(value)>(value));
+                }
+                link = &(*link)->next;
+                ++size_;
+            });
+        } catch (...) {
+            rebuildIndex();
+            throw;
+        }
+        rebuildIndex();
+    }
+    
+    /**
+     * Добавление элементов в конец списка по одному за O(1), когда элементы
+     * приходят не из одного вызова, как в appendStream(). Хранит ссылку next хвоста;
+     * узлы сверх встроенных ячеек берутся из NodeArena блоками по blockSize узлов.
+     * Пока добавитель используется, список нельзя менять другими способами
+     */
+    class Appender {
+    private:
+        LinkedList* list_;
+        std::shared_ptr<Node>* link_;
+        size_t blockSize_;
+        std::optional<ArenaAllocator<Node>> allocator_;
+    
+    public:
+        Appender(LinkedList& list, size_t blockSize) : list_(&list), link_(list.tailLink()), blockSize_(blockSize) {}
+    
+        void operator()(T value) {
+            if (list_->hasFreeSlot()) {
+                *link_ = list_->createNode(std::move(value));
+            } else {
+                if (!allocator_) {
+                    auto arena = std::make_shared<NodeArena>(blockSize_);
+                    allocator_.emplace(arena);
+                    arena->next = std::move(list_->arenas_);
+                    list_->arenas_ = std::move(arena);
+                }
+                *link_ = std::allocate_shared<Node>(*allocator_, std::move(value));
+            }
+            Node* raw = link_->get();
+            link_ = &raw->next;
+            ++list_->size_;
+            if (list_->index_) {
+                list_->index_->inserted(list_->size_ - 1, raw);
+            }
+        }
+    };
+    
+    /**
+     * Добавитель в конец списка, см. Appender
+     *
+     * @param blockSize Количество узлов в блоке арены
+     */
+    [[nodiscard]] Appender appender(size_t blockSize) {
+        return Appender(*this, blockSize);
+    }
+    
+    /**
+     * Добавление элемента в конец списка
+     */
+    void pushBack(T value) {
+        TraceSpan span("LinkedList::pushBack");
+        auto newNode = createNode(std::move(value));
+        Node* raw = newNode.get();
+        
+        if (!head_) {
+            head_ = newNode;
+        } else if (index_) {
+            // С индексом хвост находится за O(log n)
+            index_->find(size_ - 1, head_.get())->next = newNode;
+        } else {
+            auto current = head_;
+            while (current->next) {
+                current = current->next;
+            }
+            current->next = newNode;
+        }
+        
+        ++size_;
+        if (index_) {
+            index_->inserted(size_ - 1, raw);
+        }
+    }
+    
+    /**
+     * Добавление элемента в начало списка
+     */
+    void pushFront(T value) {
+        auto newNode = createNode(std::move(value));
+        newNode->next = head_;
+        head_ = newNode;
+        ++size_;
+        if (index_) {
+            index_->inserted(0, head_.get());
+        }
+    }
+    
+    /**
+     * Получение размера списка
+     */
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+    
+    /**
+     * Проверка пустой ли список
+     */
+    [[nodiscard]] bool isEmpty() const {
+        return size_ == 0;
+    }
+    
+    /**
+     * Получение указателя на голову списка. Цепочка узлов по нему владеет узлами
+     * и переживает список: встроенные узлы сначала переносятся в кучу, см. escape()
+     */
+    [[nodiscard]] std::shared_ptr<Node> getHead() const {
+        escape();
+        return head_;
+    }
+    
+    /**
+     * Обход элементов по порядку с остановкой, без выдачи ссылок на узлы
+     *
+     * @param visitor Вызывается как visitor(const T&); false прекращает обход
+     * @return false, если обход прекращен
+     */
+    template <typename Visitor>
+    bool visit(Visitor&& visitor) const {
+        for (const Node* node = head_.get(); node; node = node->next.get()) {
+            if (!visitor(node->data)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * Очистка списка
+     */
+    void clear() {
+        releaseNodes();
+        size_ = 0;
+        rebuildIndex();
+    }
+    
+    /**
+     * Включение позиционного индекса (список с пропусками поверх узлов, см. ListIndex).
+     * С индексом at, insertAt, eraseAt и pushBack работают за O(log n) в среднем,
+     * а полный обход проходит несколько отрезков списка одновременно.
+     * Индекс строится за O(n) и занимает в среднем одну башню на четыре узла.
+     * pushFront, pushBack, insertAt и eraseAt обновляют его за O(log n), остальные
+     * изменяющие операции перестраивают его за O(n).
+     * Изменения узлов в обход методов списка (через getHead()) индекс не видит
+     */
+    void enableIndex() {
+        if (!index_) {
+            index_ = std::make_unique<ListIndex<Node>>();
+        }
+        index_->rebuild(head_.get());
+    }
+    
+    void disableIndex() {
+        index_.reset();
+    }
+    
+    [[nodiscard]] bool hasIndex() const {
+        return index_ != nullptr;
+    }
+    
+    /**
+     * Элемент с номером index: O(log n) с индексом, O(n) без него
+     *
+     * @throws std::out_of_range если index >= size()
+     */
+    [[nodiscard]] T& at(size_t index) {
+        return nodeAt(index)->data;
+    }
+    
+    [[nodiscard]] const T& at(size_t index) const {
+        return nodeAt(index)->data;
+    }
+    
+    /**
+     * Вставка элемента так, чтобы он получил номер index
+     *
+     * @param index Номер нового элемента, от 0 до size() включительно
+     * @throws std::out_of_range если index > size()
+     */
+    void insertAt(size_t index, T value) {
+        if (index > size_) {
+            throw std::out_of_range("Индекс вставки за пределами списка");
+        }
+        if (index == 0) {
+            pushFront(std::move(value));
+            return;
+        }
+        
+        Node* prev = nodeAt(index - 1);
+        auto newNode = createNode(std::move(value));
+        newNode->next = std::move(prev->next);
+        prev->next = std::move(newNode);
+        ++size_;
+        if (index_) {
+            index_->inserted(index, prev->next.get());
+        }
+    }
+    
+    /**
+     * Удаление элемента с номером index
+     *
+     * @throws std::out_of_range если index >= size()
+     */
+    void eraseAt(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Индекс за пределами списка");
+        }
+        
+        std::shared_ptr<Node>& link = index == 0 ? head_ : nodeAt(index - 1)->next;
+        std::shared_ptr<Node> removed = std::move(link);
+        link = std::move(removed->next);
+        if (isInline(removed.get())) {
+            releaseSlot(removed.get());
+        } else {
+            removed.reset();
+            pruneArenas();
+        }
+        --size_;
+        if (index_) {
+            index_->erased(index);
+        }
+    }
+    
+    /**
+     * Обход элементов по порядку. С индексом несколько отрезков списка
+     * проходятся одновременно, и задержки памяти на промахах кэша перекрываются
+     *
+     * @param function Вызывается для каждого элемента как function(const T&)
+     */
+    template <typename Function>
+    void forEach(Function function) const {
+        if (index_) {
+            index_->scan(head_.get(), [&function](const Node& node) {
+                function(node.data);
+            });
+            return;
+        }
+        for (const Node* node = head_.get(); node; node = node->next.get()) {
+            function(node->data);
+        }
+    }
+    
+    /**
+     * Преобразование списка в вектор
+     */
+    [[nodiscard]] std::vector<T> toVector() const {
+        TraceSpan span("LinkedList::toVector");
+        std::vector<T> result;
+        result.reserve(size_);
+        
+        forEach([&result](const T& value) {
+            result.push_back(value);
+        });
+        
+        return result;
+    }
+    
+    /**
+     * Память, занятая списком, в байтах (O(n)): объект списка со встроенными ячейками,
+     * узлы в куче с управляющими блоками shared_ptr, арены пакетно построенных узлов
+     * (блоки целиком, вместе с еще не занятым местом), память элементов-строк и индекс.
+     * Узлы, на которые ссылается кто-то еще, учитываются в списке
+     */
+    [[nodiscard]] MemoryUsage memoryUsage() const {
+        MemoryUsage usage;
+        usage.object = sizeof(*this);
+        usage.index = index_ ? index_->memoryUsage() : 0;
+        
+        // Границы блоков арен: узел из блока уже учтен вместе с блоком
+        std::vector<std::pair<const char*, const char*>> blocks;
+        for (const NodeArena* arena = arenas_.get(); arena; arena = arena->next.get()) {
+            usage.nodes += sharedAllocationBytes<NodeArena>() + arena->blockListBytes();
+            arena->forEachBlock([&usage, &blocks](const char* data, size_t size) {
+                usage.nodes += size;
+                blocks.emplace_back(data, data + size);
+            });
+        }
+        auto byStart = [](const auto& a, const auto& b) {
+            return std::less<const char*>()(a.first, b.first);
+        };
+        std::sort(blocks.begin(), blocks.end(), byStart);
+        auto inArena = [&blocks, &byStart](const Node* node) {
+            const char* address = reinterpret_cast<const char*>(node);
+            auto it = std::upper_bound(blocks.begin(), blocks.end(), std::make_pair(address, address), byStart);
+            return it != blocks.begin() && std::less<const char*>()(address, std::prev(it)->second);
+        };
+        
+        size_t heapNodes = 0;
+        for (const Node* node = head_.get(); node; node = node->next.get()) {
+            usage.payload += MemoryUsage::payloadBytes(node->data);
+            if (!isInline(node) && !inArena(node)) {
+                ++heapNodes;
+            }
+        }
+        if (heapNodes > 0) {
+            usage.nodes += heapNodes * sharedAllocationBytes<Node>();
+        }
+        return usage;
+    }
+    
+    /**
+     * Разворот связного списка (итеративный подход)
+     * Меняет текущий список и возвращает указатель на новую голову
+     */
+    std::shared_ptr<Node> reverse() {
+        TraceSpan span("LinkedList::reverse");
+        if (!head_ || !head_->next) {
+            return getHead(); // Пустой список или список из одного элемента не требует разворота
+        }
+        
+        std::shared_ptr<Node> prev = nullptr;
+        std::shared_ptr<Node> current = head_;
+        std::shared_ptr<Node> next = nullptr;
+        
+        while (current) {
+            // Сохраняем следующий узел
+            next = current->next;
+            
+            // Меняем указатель текущего узла на предыдущий
+            current->next = prev;
+            
+            // Переходим к следующей итерации
+            prev = current;
+            current = next;
+        }
+        
+        // Обновляем голову списка
+        head_ = prev;
+        rebuildIndex();
+        
+        return getHead();
+    }
+    
+    /**
+     * Разворот отрезка списка [from, to) за один проход без выделения памяти
+     *
+     * @param from Индекс первого узла отрезка
+     * @param to Индекс узла, следующего за отрезком
+     * @return Указатель на голову списка
+     * @throws std::out_of_range если from > to или to > size()
+     */
+    std::shared_ptr<Node> reverseRange(size_t from, size_t to) {
+        if (from > to || to > size_) {
+            throw std::out_of_range("Некорректные границы отрезка для разворота");
+        }
+        if (to - from < 2) {
+            return getHead();
+        }
+        
+        std::shared_ptr<Node>* link = &head_;
+        for (size_t i = 0; i < from; ++i) {
+            link = &(*link)->next;
+        }
+        
+        *link = reverseChain(std::move(*link), to - from);
+        rebuildIndex();
+        
+        return getHead();
+    }
+    
+    /**
+     * Разворот каждой группы из k подряд идущих узлов за один проход без выделения памяти.
+     * Последняя неполная группа (меньше k узлов) остается без изменений
+     *
+     * @param k Размер группы
+     * @return Указатель на голову списка
+     * @throws std::invalid_argument если k равно 0
+     */
+    std::shared_ptr<Node> reverseInGroups(size_t k) {
+        if (k == 0) {
+            throw std::invalid_argument("Размер группы должен быть больше 0");
+        }
+        if (k == 1) {
+            return getHead();
+        }
+        
+        std::shared_ptr<Node>* link = &head_;
+        for (size_t group = 0; group < size_ / k; ++group) {
+            Node* segmentTail = link->get();
+            *link = reverseChain(std::move(*link), k);
+            // Бывшая голова группы стала ее хвостом, следующая группа начинается за ней
+            link = &segmentTail->next;
+        }
+        rebuildIndex();
+        
+        return getHead();
+    }
+    
+    /**
+     * Статический метод для разворота списка без изменения оригинального списка
+     * Возвращает новый развернутый список
+     */
+    static LinkedList<T> reverseCopy(const LinkedList<T>& list) {
+        LinkedList<T> result;
+        // Для каждого элемента в исходном списке добавляем его в начало нового списка
+        list.visit([&result](const T& value) {
+            result.pushFront(value);
+            return true;
+        });
+        
+        return result;
+    }
+    
+    /**
+     * Устойчивая сортировка слиянием снизу вверх.
+     * Узлы не копируются и не выделяются заново: меняются только указатели next,
+     * поэтому дополнительная память O(1), а время O(n log n).
+     * На больших списках в случайном порядке это медленнее, чем toVector(),
+     * std::sort и новый список: узлы разбросаны по памяти, и слияние почти
+     * на каждом шаге промахивается мимо кэша (на 10^7 int около 1300 нс
+     * против 190 нс на элемент, замеры linked_list/sortLarge*). Выигрыш -
+     * нет второй копии элементов и нового выделения узлов, а ссылки
+     * на узлы остаются действительными
+     *
+     * @param comp Функция сравнения, задающая строгий слабый порядок
+     */
+    template <typename Compare = std::less<T>>
+    void sort(Compare comp = Compare()) {
+        if (size_ < 2) {
+            return;
+        }
+        
+        // buckets[i] хранит отсортированную цепочку из 2^i узлов (или пуст).
+        // Узлы добавляются по одному, как при прибавлении единицы к двоичному счетчику,
+        // поэтому сливаются недавно пройденные, еще горячие в кэше цепочки.
+        // 64 ячеек хватает для любого size_t, то есть память не зависит от n
+        std::shared_ptr<Node> buckets[64];
+        size_t filled = 0;
+        
+        while (head_) {
+            std::shared_ptr<Node> carry = std::move(head_);
+            head_ = std::move(carry->next);
+            
+            size_t i = 0;
+            for (; i < filled && buckets[i]; ++i) {
+                // Цепочка в ячейке старше переносимой, поэтому она идет левой
+                carry = mergeChains(std::move(buckets[i]), std::move(carry), comp);
+            }
+            buckets[i] = std::move(carry);
+            if (i == filled) {
+                ++filled;
+            }
+        }
+        
+        // Младшие ячейки содержат более поздние элементы
+        for (size_t i = 0; i < filled; ++i) {
+            head_ = mergeChains(std::move(buckets[i]), std::move(head_), comp);
+        }
+        rebuildIndex();
+    }
+    
+    /**
+     * Слияние с другим отсортированным списком за O(n + m) без выделения памяти
+     * (кроме встроенных узлов other, которым не хватило свободных встроенных ячеек).
+     * Узлы other переносятся в текущий список, other становится пустым.
+     * При равенстве элементы текущего списка идут первыми
+     *
+     * @param other Отсортированный список, который будет поглощен
+     * @param comp Функция сравнения, по которой отсортированы оба списка
+     */
+    template <typename Compare = std::less<T>>
+    void merge(LinkedList&& other, Compare comp = Compare()) {
+        if (this == &other) {
+            return;
+        }
+        
+        // Выданные наружу ссылки на узлы other после слияния ведут и к узлам этого списка
+        if (other.escaped_) {
+            escape();
+            other.escaped_ = false;
+        }
+        size_ += other.size_;
+        head_ = mergeChains(std::move(head_), takeChain(other), comp);
+        adoptArenas(std::move(other.arenas_));
+        rebuildIndex();
+        other.rebuildIndex();
+    }
+    
+    /**
+     * Сохранение списка в компактном бинарном формате.
+     * Тривиально копируемые элементы пишутся как есть, строки - записями
+     * с префиксом длины. Данные копятся в буфере и пишутся блоками по 64 КБ
+     *
+     * @param path Путь к файлу
+     * @throws std::runtime_error если файл не удалось записать
+     */
+    void save(const std::string& path) const {
+        static_assert(isTriviallySerializable() || isStringSerializable(),
+                      "Сериализация поддерживается для тривиально копируемых типов и std::string");
+        
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Не удалось открыть файл для записи: " + path);
+        }
+        
+        BinaryHeader header{};
+        std::memcpy(header.magic, kBinaryMagic, sizeof(header.magic));
+        header.version = kBinaryVersion;
+        header.kind = isTriviallySerializable() ? kKindTrivial : kKindString;
+        header.elementSize = isTriviallySerializable() ? sizeof(T) : 0;
+        header.count = size_;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        
+        std::vector<char> buffer;
+        buffer.reserve(kWriteBlockSize);
+        auto append = [&](const void* bytes, size_t length) {
+            const char* src = static_cast<const char*>(bytes);
+            while (length > 0) {
+                size_t chunk = std::min(length, kWriteBlockSize - buffer.size());
+                buffer.insert(buffer.end(), src, src + chunk);
+                src += chunk;
+                length -= chunk;
+                if (buffer.size() == kWriteBlockSize) {
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            }
+        };
+        
+        for (const Node* current = head_.get(); current; current = current->next.get()) {
+            if constexpr (isTriviallySerializable()) {
+                append(&current->data, sizeof(T));
+            } else {
+                uint64_t length = current->data.size();
+                append(&length, sizeof(length));
+                append(current->data.data(), current->data.size());
+            }
+        }
+        
+        if (!buffer.empty()) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+        
+        if (!out) {
+            throw std::runtime_error("Ошибка записи в файл: " + path);
+        }
+    }
+    
+    /**
+     * Загрузка списка, сохраненного методом save().
+     * Файл отображается в память, список строится за один линейный проход,
+     * а память под все узлы выделяется одним блоком
+     *
+     * @param path Путь к файлу
+     * @return Восстановленный список
+     * @throws std::runtime_error если файл поврежден или имеет другой формат
+     */
+    static LinkedList<T> load(const std::string& path) {
+        static_assert(isTriviallySerializable() || isStringSerializable(),
+                      "Сериализация поддерживается для тривиально копируемых типов и std::string");
+        
+        MappedFile file(path);
+        if (file.size() < sizeof(BinaryHeader)) {
+            throw std::runtime_error("Файл слишком мал для заголовка списка: " + path);
+        }
+        
+        BinaryHeader header{};
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, kBinaryMagic, sizeof(header.magic)) != 0 ||
+            header.version != kBinaryVersion) {
+            throw std::runtime_error("Неизвестный формат файла списка: " + path);
+        }
+        
+        const char* cursor = file.data() + sizeof(header);
+        const char* end = file.data() + file.size();
+        
+        if constexpr (isTriviallySerializable()) {
+            if (header.kind != kKindTrivial || header.elementSize != sizeof(T)) {
+                throw std::runtime_error("Тип элементов в файле не совпадает с типом списка: " + path);
+            }
+            if (header.count > static_cast<uint64_t>(end - cursor) / sizeof(T)) {
+                throw std::runtime_error("Файл списка обрезан: " + path);
+            }
+        } else {
+            if (header.kind != kKindString) {
+                throw std::runtime_error("Тип элементов в файле не совпадает с типом списка: " + path);
+            }
+            // У каждой строки есть хотя бы префикс длины: больший счетчик - признак испорченного файла,
+            // и по нему нельзя заказывать арену
+            if (header.count > static_cast<uint64_t>(end - cursor) / sizeof(uint64_t)) {
+                throw std::runtime_error("Файл списка обрезан: " + path);
+            }
+        }
+        
+        LinkedList<T> result;
+        result.arenas_ = std::make_shared<NodeArena>(header.count);
+        ArenaAllocator<Node> allocator(result.arenas_);
+        Node* tail = nullptr;
+        
+        for (uint64_t i = 0; i < header.count; ++i) {
+            std::shared_ptr<Node> node;
+            if constexpr (isTriviallySerializable()) {
+                // Байты копируются в выровненный буфер: конструктор по умолчанию у T не нужен
+                alignas(T) unsigned char storage[sizeof(T)];
+                std::memcpy(storage, cursor, sizeof(T));
+                cursor += sizeof(T);
+                node = std::allocate_shared<Node>(allocator, *std::launder(reinterpret_cast<T*>(storage)));
+            } else {
+                uint64_t length = 0;
+                if (static_cast<size_t>(end - cursor) < sizeof(length)) {
+                    throw std::runtime_error("Файл списка обрезан: " + path);
+                }
+                std::memcpy(&length, cursor, sizeof(length));
+                cursor += sizeof(length);
+                if (length > static_cast<uint64_t>(end - cursor)) {
+                    throw std::runtime_error("Файл списка обрезан: " + path);
+                }
+                node = std::allocate_shared<Node>(allocator, std::string(cursor, length));
+                cursor += length;
+            }
+            
+            Node* raw = node.get();
+            if (tail) {
+                tail->next = std::move(node);
+            } else {
+                result.head_ = std::move(node);
+            }
+            tail = raw;
+            ++result.size_;
+        }
+        
+        return result;
+    }
+};
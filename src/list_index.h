@@ -0,0 +1,302 @@
+// list_index.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Позиционный индекс над односвязным списком: индексируемый список с пропусками.
+ *
+ * Узлы списка не меняются. Примерно каждому четвертому узлу индекс выделяет
+ * отдельную башню случайной высоты (вероятность подъема на уровень 1/4), ссылки
+ * башни хранят ширину - на сколько позиций они перепрыгивают. Поиск по позиции
+ * спускается по башням и проходит по next в среднем не больше четырех узлов,
+ * поэтому поиск, вставка и удаление по позиции работают за O(log n) в среднем.
+ *
+ * Позиции внутри индекса сдвинуты на единицу: 0 - голова индекса, i + 1 - элемент i.
+ * Ширина ссылки без следующей башни не используется и не поддерживается
+ *
+ * @tparam Node Узел списка с полем next (умный указатель на следующий узел)
+ */
+template <typename Node>
+class ListIndex {
+public:
+    static constexpr size_t kMaxLevel = 16;
+    // Число отрезков списка, которые обход проходит одновременно
+    static constexpr size_t kScanLanes = 8;
+
+private:
+    struct Tower;
+
+    struct Link {
+        Tower* next;
+        size_t width;
+    };
+
+    struct Tower {
+        Node* node;
+        std::vector<Link> links;
+
+        Tower(Node* towerNode, size_t height) : node(towerNode), links(height, Link{nullptr, 0}) {}
+    };
+
+    Tower head_;
+    size_t levels_;
+    uint64_t state_;
+
+    /**
+     * Высота башни нового узла: 0 с вероятностью 3/4
+     */
+    size_t randomHeight() {
+        // xorshift64: быстрый генератор, криптостойкость не нужна
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        uint64_t bits = state_;
+        size_t height = 0;
+        while (height < kMaxLevel && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    /**
+     * Последние башни строго левее позиции position на каждом используемом уровне
+     */
+    void locate(size_t position, Tower** update, size_t* updatePosition) {
+        Tower* tower = &head_;
+        size_t current = 0;
+        for (size_t level = levels_; level-- > 0;) {
+            while (tower->links[level].next && current + tower->links[level].width < position) {
+                current += tower->links[level].width;
+                tower = tower->links[level].next;
+            }
+            update[level] = tower;
+            updatePosition[level] = current;
+        }
+    }
+
+    void release() {
+        Tower* tower = head_.links[0].next;
+        while (tower) {
+            Tower* next = tower->links[0].next;
+            delete tower;
+            tower = next;
+        }
+        std::fill(head_.links.begin(), head_.links.end(), Link{nullptr, 0});
+        levels_ = 0;
+    }
+
+public:
+    ListIndex() : head_(nullptr, kMaxLevel), levels_(0), state_(0x9E3779B97F4A7C15ULL) {}
+
+    ListIndex(const ListIndex&) = delete;
+    ListIndex& operator=(const ListIndex&) = delete;
+
+    ~ListIndex() {
+        release();
+    }
+
+    /**
+     * Построение индекса заново за O(n) - после операций, переставляющих много узлов
+     *
+     * @param first Первый узел списка
+     */
+    void rebuild(Node* first) {
+        release();
+
+        Tower* last[kMaxLevel];
+        size_t lastPosition[kMaxLevel];
+        std::fill(last, last + kMaxLevel, &head_);
+        std::fill(lastPosition, lastPosition + kMaxLevel, size_t(0));
+
+        size_t position = 1;
+        for (Node* node = first; node; node = node->next.get(), ++position) {
+            size_t height = randomHeight();
+            if (height == 0) {
+                continue;
+            }
+            Tower* tower = new Tower(node, height);
+            for (size_t level = 0; level < height; ++level) {
+                last[level]->links[level] = Link{tower, position - lastPosition[level]};
+                last[level] = tower;
+                lastPosition[level] = position;
+            }
+            levels_ = std::max(levels_, height);
+        }
+    }
+
+    /**
+     * Перевод башен на узлы тех же позиций, когда узлы списка заменены другими
+     * (перемещение списка со встроенными узлами), за O(n) без выделения памяти
+     *
+     * @param first Первый узел списка
+     */
+    void relocate(Node* first) noexcept {
+        Node* node = first;
+        size_t position = 1;
+        size_t towerPosition = 0;
+        for (Tower* tower = &head_; tower->links[0].next; tower = tower->links[0].next) {
+            towerPosition += tower->links[0].width;
+            for (; position < towerPosition; ++position) {
+                node = node->next.get();
+            }
+            tower->links[0].next->node = node;
+        }
+    }
+
+    /**
+     * Узел с номером index (индекс должен быть меньше размера списка)
+     *
+     * @param first Первый узел списка
+     */
+    Node* find(size_t index, Node* first) const {
+        size_t target = index + 1;
+        const Tower* tower = &head_;
+        size_t current = 0;
+        for (size_t level = levels_; level-- > 0;) {
+            while (tower->links[level].next && current + tower->links[level].width <= target) {
+                current += tower->links[level].width;
+                tower = tower->links[level].next;
+            }
+        }
+
+        Node* node = tower == &head_ ? first : tower->node;
+        for (size_t position = tower == &head_ ? 1 : current; position < target; ++position) {
+            node = node->next.get();
+        }
+        return node;
+    }
+
+    /**
+     * Учет узла, только что вставленного в список на место index
+     */
+    void inserted(size_t index, Node* node) {
+        size_t target = index + 1;
+        size_t height = randomHeight();
+        // Новые уровни начинаются с головы индекса, locate их заполнит
+        levels_ = std::max(levels_, height);
+
+        Tower* update[kMaxLevel];
+        size_t updatePosition[kMaxLevel];
+        locate(target, update, updatePosition);
+
+        Tower* tower = height > 0 ? new Tower(node, height) : nullptr;
+        for (size_t level = 0; level < levels_; ++level) {
+            Link& link = update[level]->links[level];
+            if (level < height) {
+                // Элементы правее target сдвинулись на одну позицию
+                tower->links[level] = Link{link.next, updatePosition[level] + link.width + 1 - target};
+                link = Link{tower, target - updatePosition[level]};
+            } else {
+                ++link.width;
+            }
+        }
+    }
+
+    /**
+     * Учет узла, только что удаленного из списка с места index
+     */
+    void erased(size_t index) {
+        size_t target = index + 1;
+        Tower* update[kMaxLevel];
+        size_t updatePosition[kMaxLevel];
+        locate(target, update, updatePosition);
+
+        Tower* removed = nullptr;
+        for (size_t level = 0; level < levels_; ++level) {
+            Link& link = update[level]->links[level];
+            if (link.next && updatePosition[level] + link.width == target) {
+                removed = link.next;
+                link = Link{removed->links[level].next, link.width + removed->links[level].width - 1};
+            } else {
+                --link.width;
+            }
+        }
+        delete removed;
+
+        while (levels_ > 0 && !head_.links[levels_ - 1].next) {
+            --levels_;
+        }
+    }
+
+    /**
+     * Обход всех узлов по порядку. Башни нижнего уровня делят список на отрезки,
+     * kScanLanes отрезков проходятся одновременно: переходы по next в разных
+     * отрезках независимы, и процессор ждет несколько промахов кэша сразу,
+     * а не по одному
+     *
+     * @param first Первый узел списка
+     * @param visit Вызывается для каждого узла в порядке списка
+     */
+    template <typename Visitor>
+    void scan(Node* first, Visitor visit) const {
+        // Длина последнего отрезка неизвестна: он продолжается до конца списка
+        constexpr size_t kTail = SIZE_MAX;
+        std::vector<Node*> buffers[kScanLanes];
+        const Tower* tower = &head_;
+        size_t position = 0;
+        Node* start = first;
+
+        while (start) {
+            // Начала и длины следующих отрезков берутся из башен нижнего уровня
+            Node* cursors[kScanLanes];
+            size_t lengths[kScanLanes];
+            size_t lanes = 0;
+            size_t longest = 0;
+            for (; lanes < kScanLanes && start; ++lanes) {
+                const Tower* next = levels_ > 0 ? tower->links[0].next : nullptr;
+                cursors[lanes] = start;
+                if (next) {
+                    size_t begin = tower == &head_ ? 1 : position;
+                    lengths[lanes] = position + tower->links[0].width - begin;
+                    longest = std::max(longest, lengths[lanes]);
+                    position += tower->links[0].width;
+                    tower = next;
+                    start = next->node;
+                } else {
+                    lengths[lanes] = kTail;
+                    start = nullptr;
+                }
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                buffers[lane].clear();
+            }
+            // Чередующийся проход: по одному шагу в каждом отрезке
+            for (size_t step = 0; step < longest; ++step) {
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    if (step < lengths[lane] && lengths[lane] != kTail) {
+                        buffers[lane].push_back(cursors[lane]);
+                        cursors[lane] = cursors[lane]->next.get();
+                    }
+                }
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                for (Node* node : buffers[lane]) {
+                    visit(*node);
+                }
+            }
+            // Последний отрезок (после последней башни) проходится обычным образом
+            if (lanes > 0 && lengths[lanes - 1] == kTail) {
+                for (Node* node = cursors[lanes - 1]; node; node = node->next.get()) {
+                    visit(*node);
+                }
+            }
+        }
+    }
+    /**
+     * Память индекса в байтах: сам объект, башни и их ссылки
+     */
+    [[nodiscard]] size_t memoryUsage() const {
+        size_t bytes = sizeof(*this) + head_.links.capacity() * sizeof(Link);
+        for (const Tower* tower = levels_ > 0 ? head_.links[0].next : nullptr; tower; tower = tower->links[0].next) {
+            bytes += sizeof(Tower) + tower->links.capacity() * sizeof(Link);
+        }
+        return bytes;
+    }
+};
@@ -0,0 +1,180 @@
+// list_view.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "linked_list.h"
+
+/**
+ * Ленивое представление элементов списка. Преобразования map, filter, take
+ * и reversed ничего не вычисляют, а только собирают новое представление;
+ * завершающие операции (forEach, toVector, collect) проходят исходный список
+ * один раз, пропуская каждый элемент через все стадии сразу.
+ *
+ * Источник - вызываемый объект source(sink), который передает элементы
+ * в sink(value) по одному; sink возвращает false, когда элементы больше
+ * не нужны (так take останавливает проход). Представление хранит ссылку
+ * на список, поэтому список должен жить, пока представление используется.
+ *
+ * Пример: квадраты первых десяти четных элементов
+ *   auto squares = ListViews::from(list)
+ *       .filter([](int x) { return x % 2 == 0; })
+ *       .map([](int x) { return x * x; })
+ *       .take(10)
+ *       .collect();
+ *
+ * @tparam T Тип элементов представления
+ * @tparam Source Тип источника элементов
+ */
+template <typename T, typename Source>
+class ListView {
+private:
+    Source source_;
+    // Верхняя граница числа элементов; exact_ - граница точная (не было filter)
+    size_t bound_;
+    bool exact_;
+
+    template <typename U, typename OtherSource>
+    static ListView<U, OtherSource> make(OtherSource source, size_t bound, bool exact) {
+        return ListView<U, OtherSource>(std::move(source), bound, exact);
+    }
+
+public:
+    using value_type = T;
+
+    // Размер блока узлов для collect(), когда число элементов известно только сверху
+    static constexpr size_t kCollectChunk = 1024;
+
+    ListView(Source source, size_t bound, bool exact) : source_(std::move(source)), bound_(bound), exact_(exact) {}
+
+    /**
+     * Применение function к каждому элементу
+     *
+     * @param function Вызывается как function(const T&), результат - элемент нового представления
+     */
+    template <typename Function>
+    [[nodiscard]] auto map(Function function) const {
+        using U = std::decay_t<std::invoke_result_t<const Function&, const T&>>;
+        auto source = [source = source_, function](auto&& sink) {
+            return source([&sink, &function](const T& value) {
+                return sink(function(value));
+            });
+        };
+        return make<U>(std::move(source), bound_, exact_);
+    }
+
+    /**
+     * Только элементы, для которых predicate(const T&) возвращает true
+     */
+    template <typename Predicate>
+    [[nodiscard]] auto filter(Predicate predicate) const {
+        auto source = [source = source_, predicate](auto&& sink) {
+            return source([&sink, &predicate](const T& value) {
+                return predicate(value) ? sink(value) : true;
+            });
+        };
+        return make<T>(std::move(source), bound_, false);
+    }
+
+    /**
+     * Не больше count первых элементов; после count-го элемента проход
+     * исходного списка прекращается
+     */
+    [[nodiscard]] auto take(size_t count) const {
+        auto source = [source = source_, count](auto&& sink) {
+            if (count == 0) {
+                return true;
+            }
+            size_t taken = 0;
+            return source([&sink, &taken, count](const T& value) {
+                return sink(value) && ++taken < count;
+            });
+        };
+        return make<T>(std::move(source), std::min(bound_, count), exact_);
+    }
+
+    /**
+     * Элементы в обратном порядке. Односвязный список нельзя пройти с конца,
+     * поэтому стадия копит элементы предыдущих стадий во временном векторе
+     */
+    [[nodiscard]] auto reversed() const {
+        auto source = [source = source_, bound = exact_ ? bound_ : 0](auto&& sink) {
+            std::vector<T> buffer;
+            buffer.reserve(bound);
+            source([&buffer](const T& value) {
+                buffer.push_back(value);
+                return true;
+            });
+            for (auto it = buffer.rbegin(); it != buffer.rend(); ++it) {
+                if (!sink(*it)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        return make<T>(std::move(source), bound_, exact_);
+    }
+
+    /**
+     * Проход всех элементов представления
+     *
+     * @param function Вызывается для каждого элемента как function(const T&)
+     */
+    template <typename Function>
+    void forEach(Function function) const {
+        source_([&function](const T& value) {
+            function(value);
+            return true;
+        });
+    }
+
+    [[nodiscard]] std::vector<T> toVector() const {
+        std::vector<T> result;
+        result.reserve(exact_ ? bound_ : 0);
+        forEach([&result](const T& value) {
+            result.push_back(value);
+        });
+        return result;
+    }
+
+    /**
+     * Новый список из элементов представления за один проход. Узлы берутся
+     * блоками (см. LinkedList::appendStream): одним блоком, если число
+     * элементов известно, иначе блоками по kCollectChunk узлов
+     */
+    [[nodiscard]] LinkedList<T> collect() const {
+        LinkedList<T> result;
+        result.appendStream(exact_ ? bound_ : std::min(bound_, kCollectChunk), [this](auto&& emit) {
+            forEach(emit);
+        });
+        return result;
+    }
+
+    /**
+     * Верхняя граница числа элементов (точное число, если не было filter)
+     */
+    [[nodiscard]] size_t sizeBound() const {
+        return bound_;
+    }
+};
+
+/**
+ * Создание ленивых представлений списков
+ */
+class ListViews {
+public:
+    /**
+     * Представление всех элементов списка по порядку
+     */
+    template <typename T>
+    [[nodiscard]] static auto from(const LinkedList<T>& list) {
+        auto source = [&list](auto&& sink) {
+            return list.visit(sink);
+        };
+        return ListView<T, decltype(source)>(std::move(source), list.size(), true);
+    }
+};
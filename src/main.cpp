@@ -6,6 +6,8 @@
 #include "fibonacci.h"
 #include "palindrome.h"
 #include "linked_list.h"
+#include "pipeline_stages.h"
+#include "trace.h"
 
 // Функция для вывода меню
 void printMenu() {
@@ -13,8 +15,9 @@ void printMenu() {
     std::cout << "1. Генерация чисел Фибоначчи\n";
     std::cout << "2. Проверка палиндрома\n";
     std::cout << "3. Разворот связного списка\n";
+    std::cout << "4. Конвейер: палиндромные числа Фибоначчи в развернутом списке\n";
     std::cout << "0. Выход\n";
-    std::cout << "Выберите задачу (0-3): ";
+    std::cout << "Выберите задачу (0-4): ";
 }
 
 // Функция для обработки задачи с числами Фибоначчи
@@ -124,10 +127,44 @@ void linkedListTask() {
     printList(copyList);
 }
 
-int main() {
+// Функция для составной задачи: генерация -> фильтр палиндромов -> список -> разворот
+void pipelineTask() {
+    std::cout << "\n--- КОНВЕЙЕР ---\n";
+    
+    unsigned int n;
+    std::cout << "Введите количество чисел Фибоначчи для генерации: ";
+    std::cin >> n;
+    
+    try {
+        LinkedList<unsigned long long> list;
+        
+        // Каждая стадия работает в своем потоке, числа передаются пакетами
+        Pipeline pipeline;
+        pipeline.source<unsigned long long>(PipelineStages::fibonacci(n))
+                .filter(PipelineStages::palindromes())
+                .forEach(PipelineStages::appendTo(list));
+        pipeline.wait();
+        
+        list.reverse();
+        
+        std::cout << "Палиндромные числа Фибоначчи в обратном порядке: ";
+        printList(list);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
     // Устанавливаем локаль для корректного отображения русских символов
     setlocale(LC_ALL, "");
     
+    // Трассировка: --trace <файл> или переменная окружения ALGORITHMS_TRACE
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--trace" && i + 1 < argc) {
+            Tracer::instance().enable(argv[++i]);
+        }
+    }
+    
     int choice;
     
     do {
@@ -138,7 +175,7 @@ int main() {
         if (std::cin.fail()) {
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Ошибка ввода. Пожалуйста, введите число от 0 до 3.\n";
+            std::cout << "Ошибка ввода. Пожалуйста, введите число от 0 до 4.\n";
             continue;
         }
         
@@ -152,13 +189,22 @@ int main() {
             case 3:
                 linkedListTask();
                 break;
+            case 4:
+                pipelineTask();
+                break;
             case 0:
                 std::cout << "Выход из программы.\n";
                 break;
             default:
-                std::cout << "Неверный выбор. Пожалуйста, введите число от 0 до 3.\n";
+                std::cout << "Неверный выбор. Пожалуйста, введите число от 0 до 4.\n";
         }
     } while (choice != 0);
     
+    try {
+        Tracer::instance().flush();
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+    }
+    
     return 0;
 }
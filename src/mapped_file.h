@@ -0,0 +1,79 @@
+// mapped_file.h
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * RAII-обертка над файлом, отображенным в память только для чтения (mmap)
+ */
+class MappedFile {
+private:
+    const char* data_;
+    size_t size_;
+
+public:
+    /**
+     * Отображает файл в память целиком
+     *
+     * @param path Путь к файлу
+     * @throws std::runtime_error если файл не удалось открыть или отобразить
+     */
+    explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Не удалось открыть файл: " + path);
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Не удалось получить размер файла: " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        // mmap не поддерживает отображение пустых файлов
+        if (size_ > 0) {
+            void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Не удалось отобразить файл в память: " + path);
+            }
+            // Файл читается последовательно, подсказываем это ядру
+            ::madvise(mapped, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(mapped);
+        }
+
+        // Отображение остается действительным после закрытия дескриптора
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    /**
+     * Указатель на начало отображенных данных (nullptr для пустого файла)
+     */
+    [[nodiscard]] const char* data() const {
+        return data_;
+    }
+
+    /**
+     * Размер отображенного файла в байтах
+     */
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+};
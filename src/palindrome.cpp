@@ -1,78 +1,3 @@
-// palindrome.h
-#pragma once
-
-#include <string>
-#include <algorithm>
-#include <cctype>
-
-class PalindromeChecker {
-public:
-    /**
-     * Проверяет, является ли число палиндромом
-     * 
-     * @param number Число для проверки
-     * @return true если число является палиндромом, false в противном случае
-     */
-    static bool isPalindrome(long long number) {
-        // Преобразуем число в строку для упрощения сравнения
-        std::string str = std::to_string(number);
-        
-        // Для отрицательных чисел удаляем знак минус (опционально)
-        if (number < 0) {
-            str = str.substr(1);
-        }
-        
-        // Сравниваем строку с ее обратной версией
-        std::string reversedStr = str;
-        std::reverse(reversedStr.begin(), reversedStr.end());
-        
-        return str == reversedStr;
-    }
-    
-    /**
-     * Альтернативный метод проверки палиндрома без преобразования числа в строку
-     * 
-     * @param number Число для проверки
-     * @return true если число является палиндромом, false в противном случае
-     */
-    static bool isPalindromeNumeric(long long number) {
-        // Обрабатываем отрицательные числа (опционально)
-        if (number < 0) {
-            number = -number;
-        }
-        
-        // Обработка краевого случая для 0
-        if (number == 0) {
-            return true;
-        }
-        
-        // Если число заканчивается на 0, но не равно 0, то оно не может быть палиндромом
-        if (number % 10 == 0) {
-            return false;
-        }
-        
-        long long reversed = 0;
-        long long original = number;
-        
-        // Разворачиваем число
-        while (number > 0) {
-            // Добавляем последнюю цифру к развернутому числу
-            long long digit = number % 10;
-            
-            // Проверка на переполнение перед умножением
-            if (reversed > LLONG_MAX / 10) {
-                throw std::overflow_error("Переполнение при вычислении перевернутого числа");
-            }
-            reversed = reversed * 10 + digit;
-            
-            // Удаляем последнюю цифру из исходного числа
-            number /= 10;
-        }
-        
-        return original == reversed;
-    }
-};
-
 // palindrome_test.cpp
 #include <gtest/gtest.h>
 #include "palindrome.h"
@@ -0,0 +1,417 @@
+// palindrome.h
+#pragma once
+
+#include <string>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "trace.h"
+
+/**
+ * Построение таблицы разворота пар цифр на этапе компиляции
+ */
+constexpr std::array<uint8_t, 100> makeDigitPairReversedTable() {
+    std::array<uint8_t, 100> table{};
+    for (int pair = 0; pair < 100; ++pair) {
+        table[pair] = static_cast<uint8_t>((pair % 10) * 10 + pair / 10);
+    }
+    return table;
+}
+
+class PalindromeChecker {
+private:
+    /**
+     * Количество десятичных цифр числа (для 0 - одна цифра)
+     */
+    template <typename U>
+    static int countDigits(U value) {
+        int digits = 1;
+        while (value >= 10) {
+            value /= 10;
+            ++digits;
+        }
+        return digits;
+    }
+    
+    template <typename U>
+    static U powerOfTen(int exponent) {
+        U result = 1;
+        for (int i = 0; i < exponent; ++i) {
+            result *= 10;
+        }
+        return result;
+    }
+    
+    /**
+     * Строит палиндром из digits цифр, зеркально отражая старшую половину half
+     */
+    template <typename U>
+    static U mirror(U half, int digits) {
+        U result = half;
+        U rest = (digits % 2 == 1) ? half / 10 : half;
+        while (rest > 0) {
+            result = result * 10 + rest % 10;
+            rest /= 10;
+        }
+        return result;
+    }
+    
+    /**
+     * Наименьший палиндром, не меньший value, за O(количество цифр)
+     */
+    template <typename U>
+    static U smallestPalindromeNotLess(U value) {
+        int digits = countDigits(value);
+        int halfDigits = (digits + 1) / 2;
+        U half = value / powerOfTen<U>(digits - halfDigits);
+        
+        U candidate = mirror(half, digits);
+        if (candidate >= value) {
+            return candidate;
+        }
+        
+        // Увеличиваем старшую половину; перенос из 99..9 дает палиндром 100..001
+        ++half;
+        if (half == powerOfTen<U>(halfDigits)) {
+            return powerOfTen<U>(digits) + 1;
+        }
+        return mirror(half, digits);
+    }
+    
+    /**
+     * Наибольший палиндром, не превосходящий value, за O(количество цифр)
+     */
+    template <typename U>
+    static U largestPalindromeNotGreater(U value) {
+        if (value < 10) {
+            return value;
+        }
+        
+        int digits = countDigits(value);
+        int halfDigits = (digits + 1) / 2;
+        U half = value / powerOfTen<U>(digits - halfDigits);
+        
+        U candidate = mirror(half, digits);
+        if (candidate <= value) {
+            return candidate;
+        }
+        
+        // Уменьшаем старшую половину; заем из 10..0 дает палиндром 99..9 на цифру короче
+        --half;
+        if (half < powerOfTen<U>(halfDigits - 1)) {
+            return powerOfTen<U>(digits - 1) - 1;
+        }
+        return mirror(half, digits);
+    }
+    
+    /**
+     * Общая реализация next/prev для знакового типа S с беззнаковым модулем U.
+     * Как и в isPalindrome, знак не учитывается: -121 считается палиндромом,
+     * поэтому для отрицательных чисел поиск вверх превращается в поиск вниз по модулю
+     */
+    template <typename S, typename U>
+    static S nextPalindromeImpl(S number) {
+        if (number >= 0) {
+            U result = smallestPalindromeNotLess(static_cast<U>(number));
+            if (result > static_cast<U>(std::numeric_limits<S>::max())) {
+                throw std::overflow_error("Следующий палиндром выходит за пределы типа");
+            }
+            return static_cast<S>(result);
+        }
+        
+        U magnitude = U(0) - static_cast<U>(number);
+        return static_cast<S>(U(0) - largestPalindromeNotGreater(magnitude));
+    }
+    
+    template <typename S, typename U>
+    static S prevPalindromeImpl(S number) {
+        if (number >= 0) {
+            return static_cast<S>(largestPalindromeNotGreater(static_cast<U>(number)));
+        }
+        
+        U magnitude = U(0) - static_cast<U>(number);
+        U result = smallestPalindromeNotLess(magnitude);
+        if (result > U(0) - static_cast<U>(std::numeric_limits<S>::min())) {
+            throw std::overflow_error("Предыдущий палиндром выходит за пределы типа");
+        }
+        return static_cast<S>(U(0) - result);
+    }
+    
+    template <typename S, typename U>
+    static S nearestPalindromeImpl(S number) {
+        // У краев диапазона типа один из соседей может не существовать, но не оба
+        S lower = 0;
+        bool hasLower = true;
+        try {
+            lower = prevPalindromeImpl<S, U>(number);
+        } catch (const std::overflow_error&) {
+            hasLower = false;
+        }
+        if (hasLower && lower == number) {
+            return number;
+        }
+        
+        S upper = 0;
+        try {
+            upper = nextPalindromeImpl<S, U>(number);
+        } catch (const std::overflow_error&) {
+            return lower;
+        }
+        if (!hasLower) {
+            return upper;
+        }
+        
+        // Разности считаем в беззнаковом типе, чтобы не переполниться
+        U below = static_cast<U>(number) - static_cast<U>(lower);
+        U above = static_cast<U>(upper) - static_cast<U>(number);
+        return above < below ? upper : lower;
+    }
+    
+    // Таблица разворота пар цифр: kDigitPairReversed[10 * a + b] == 10 * b + a
+    static constexpr std::array<uint8_t, 100> kDigitPairReversed = makeDigitPairReversedTable();
+    
+    static constexpr uint64_t kPowersOfTen[20] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+        100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+        10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+    };
+    
+    /**
+     * Количество цифр без делений: оценка log10 через номер старшего бита
+     * (log10(2) ~ 1233 / 4096) и одна поправка по таблице степеней десяти
+     */
+    static int countDigitsFast(uint64_t value) {
+        int estimate = ((64 - __builtin_clzll(value | 1)) * 1233) >> 12;
+        return estimate - (value < kPowersOfTen[estimate]) + 1;
+    }
+    
+    // Целые типы, значения которых помещаются в long long. Беззнаковые 64-битные
+    // сюда не входят: они уходят в перегрузку для __int128 без потери старшего бита
+    template <typename Integer>
+    using EnableIfSmallInteger =
+        typename std::enable_if<std::is_integral<Integer>::value &&
+                                    (sizeof(Integer) < sizeof(long long) || std::is_signed<Integer>::value),
+                                int>::type;
+    
+public:
+    /**
+     * Проверяет, является ли число палиндромом
+     * 
+     * @param number Число для проверки
+     * @return true если число является палиндромом, false в противном случае
+     */
+    static bool isPalindrome(long long number) {
+        TraceSpan span("PalindromeChecker::isPalindrome");
+        // Преобразуем число в строку для упрощения сравнения
+        std::string str = std::to_string(number);
+
+        // Для отрицательных чисел пропускаем знак минус (опционально)
+        auto begin = number < 0 ? str.begin() + 1 : str.begin();
+
+        // Сравниваем первую половину строки с перевернутой второй, без копии строки
+        return std::equal(begin, begin + (str.end() - begin) / 2, str.rbegin());
+    }
+    
+    /**
+     * Альтернативный метод проверки палиндрома без преобразования числа в строку
+     * 
+     * @param number Число для проверки
+     * @return true если число является палиндромом, false в противном случае
+     */
+    static bool isPalindromeNumeric(long long number) {
+        TraceSpan span("PalindromeChecker::isPalindromeNumeric");
+        // Обрабатываем отрицательные числа (опционально)
+        if (number < 0) {
+            number = -number;
+        }
+        
+        // Обработка краевого случая для 0
+        if (number == 0) {
+            return true;
+        }
+        
+        // Если число заканчивается на 0, но не равно 0, то оно не может быть палиндромом
+        if (number % 10 == 0) {
+            return false;
+        }
+        
+        long long reversed = 0;
+        long long original = number;
+        
+        // Разворачиваем число
+        while (number > 0) {
+            // Добавляем последнюю цифру к развернутому числу
+            long long digit = number % 10;
+            
+            // Проверка на переполнение перед умножением
+            if (reversed > LLONG_MAX / 10) {
+                throw std::overflow_error("Переполнение при вычислении перевернутого числа");
+            }
+            reversed = reversed * 10 + digit;
+            
+            // Удаляем последнюю цифру из исходного числа
+            number /= 10;
+        }
+        
+        return original == reversed;
+    }
+    
+    /**
+     * Быстрая числовая проверка палиндрома по таблице пар цифр.
+     * Младшая половина числа снимается по 4 цифры за шаг и разворачивается
+     * по таблице, после чего сравнивается со старшей половиной.
+     * Все деления - на константы 10, 100 и 10000, которые компилятор заменяет
+     * умножением на обратное, а число шагов не больше 5 для любых 19 цифр
+     * 
+     * @param number Число для проверки
+     * @return true если число является палиндромом, false в противном случае
+     */
+    static bool isPalindromeDigitTable(long long number) {
+        // Модуль в беззнаковом типе корректен и для LLONG_MIN
+        uint64_t value = number < 0 ? 0ULL - static_cast<uint64_t>(number) : static_cast<uint64_t>(number);
+        if (value < 10) {
+            return true;
+        }
+        
+        int digits = countDigitsFast(value);
+        int remaining = digits / 2;
+        uint64_t reversed = 0;
+        
+        while (remaining >= 4) {
+            uint32_t quad = static_cast<uint32_t>(value % 10000);
+            value /= 10000;
+            reversed = reversed * 10000 + kDigitPairReversed[quad % 100] * 100u + kDigitPairReversed[quad / 100];
+            remaining -= 4;
+        }
+        if (remaining >= 2) {
+            reversed = reversed * 100 + kDigitPairReversed[value % 100];
+            value /= 100;
+            remaining -= 2;
+        }
+        if (remaining == 1) {
+            reversed = reversed * 10 + value % 10;
+            value /= 10;
+        }
+        
+        // У числа с нечетным количеством цифр средняя цифра не участвует в сравнении
+        if (digits & 1) {
+            value /= 10;
+        }
+        
+        return value == reversed;
+    }
+    
+    /**
+     * Стратегии проверки для isPalindromeWith, позволяющие сравнивать методы в бенчмарках
+     */
+    struct StringMethod {
+        static bool check(long long number) {
+            return isPalindrome(number);
+        }
+    };
+    
+    struct NumericMethod {
+        static bool check(long long number) {
+            return isPalindromeNumeric(number);
+        }
+    };
+    
+    struct DigitTableMethod {
+        static bool check(long long number) {
+            return isPalindromeDigitTable(number);
+        }
+    };
+    
+    /**
+     * Проверка палиндрома выбранным на этапе компиляции методом
+     * 
+     * @tparam Method StringMethod, NumericMethod или DigitTableMethod
+     * @param number Число для проверки
+     * @return true если число является палиндромом, false в противном случае
+     */
+    template <typename Method = DigitTableMethod>
+    static bool isPalindromeWith(long long number) {
+        return Method::check(number);
+    }
+    
+    /**
+     * Наименьший палиндром, не меньший number, построенный отражением старшей половины цифр.
+     * Работает за O(количество цифр) вместо перебора чисел подряд.
+     * Знак, как и в isPalindrome, не учитывается
+     * 
+     * @param number Исходное число
+     * @return Наименьший палиндром >= number
+     * @throws std::overflow_error если такой палиндром не помещается в long long
+     */
+    template <typename Integer, EnableIfSmallInteger<Integer> = 0>
+    static long long nextPalindrome(Integer number) {
+        return nextPalindromeImpl<long long, unsigned long long>(static_cast<long long>(number));
+    }
+    
+    static __int128 nextPalindrome(__int128 number) {
+        return nextPalindromeImpl<__int128, unsigned __int128>(number);
+    }
+    
+    /**
+     * Наибольший палиндром, не превосходящий number, за O(количество цифр)
+     * 
+     * @param number Исходное число
+     * @return Наибольший палиндром <= number
+     * @throws std::overflow_error если такой палиндром не помещается в long long
+     */
+    template <typename Integer, EnableIfSmallInteger<Integer> = 0>
+    static long long prevPalindrome(Integer number) {
+        return prevPalindromeImpl<long long, unsigned long long>(static_cast<long long>(number));
+    }
+    
+    static __int128 prevPalindrome(__int128 number) {
+        return prevPalindromeImpl<__int128, unsigned __int128>(number);
+    }
+    
+    /**
+     * Ближайший к number палиндром (сам number, если он палиндром).
+     * При равном расстоянии выбирается меньший палиндром
+     * 
+     * @param number Исходное число
+     * @return Ближайший палиндром
+     */
+    template <typename Integer, EnableIfSmallInteger<Integer> = 0>
+    static long long nearestPalindrome(Integer number) {
+        return nearestPalindromeImpl<long long, unsigned long long>(static_cast<long long>(number));
+    }
+    
+    static __int128 nearestPalindrome(__int128 number) {
+        return nearestPalindromeImpl<__int128, unsigned __int128>(number);
+    }
+    
+    /**
+     * Пакетные версии запросов: results[i] - ответ для numbers[i]
+     * 
+     * @throws std::overflow_error если ответ для какого-либо числа не помещается в long long
+     */
+    static void nextPalindromeBatch(const long long* numbers, size_t count, long long* results) {
+        for (size_t i = 0; i < count; ++i) {
+            results[i] = nextPalindromeImpl<long long, unsigned long long>(numbers[i]);
+        }
+    }
+    
+    static void prevPalindromeBatch(const long long* numbers, size_t count, long long* results) {
+        for (size_t i = 0; i < count; ++i) {
+            results[i] = prevPalindromeImpl<long long, unsigned long long>(numbers[i]);
+        }
+    }
+    
+    static void nearestPalindromeBatch(const long long* numbers, size_t count, long long* results) {
+        for (size_t i = 0; i < count; ++i) {
+            results[i] = nearestPalindromeImpl<long long, unsigned long long>(numbers[i]);
+        }
+    }
+};
@@ -0,0 +1,196 @@
+// palindromic_substrings.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.h"
+
+/**
+ * Палиндромная подстрока: смещение от начала данных и длина
+ */
+struct PalindromeMatch {
+    size_t offset;
+    size_t length;
+};
+
+/**
+ * Поиск палиндромных подстрок алгоритмом Манакера за линейное время.
+ *
+ * Алгоритм работает с неявной строкой вида #a#b#c#: разделители не хранятся,
+ * а вычисляются по четности индекса. Для каждой позиции хранится только радиус,
+ * причем буфер радиусов один на объект и переиспользуется между вызовами.
+ *
+ * Потоковый режим (методы *InFile) обрабатывает файл, отображенный в память,
+ * окнами фиксированного размера, поэтому объем рабочей памяти не зависит
+ * от размера файла. Цена этого - ограничение maxLength на длину палиндрома
+ */
+class PalindromicSubstrings {
+public:
+    static constexpr size_t kDefaultStreamChunkSize = 1 << 22;
+
+private:
+    std::vector<size_t> radii_;
+    size_t streamChunkSize_;
+
+    /**
+     * Радиусы палиндромов для всех 2n+1 центров неявной строки
+     */
+    void computeRadii(const unsigned char* data, size_t size) {
+        size_t length = 2 * size + 1;
+        if (radii_.size() < length) {
+            radii_.resize(length);
+        }
+
+        // Нечетные позиции - символы, четные - разделители, равные только друг другу
+        auto matches = [data](size_t left, size_t right) {
+            return (left & 1) == 0 || data[left >> 1] == data[right >> 1];
+        };
+
+        size_t center = 0;
+        size_t right = 0;
+        for (size_t i = 0; i < length; ++i) {
+            size_t radius = 0;
+            if (i < right) {
+                radius = std::min(right - i, radii_[2 * center - i]);
+            }
+            while (radius < i && i + radius + 1 < length && matches(i - radius - 1, i + radius + 1)) {
+                ++radius;
+            }
+            radii_[i] = radius;
+            if (i + radius > right) {
+                center = i;
+                right = i + radius;
+            }
+        }
+    }
+
+    /**
+     * Обход всех центров с радиусами, ограниченными maxLength.
+     * Данные делятся на куски по chunkSize, каждый кусок обрабатывается вместе
+     * с запасом в половину maxLength с обеих сторон, чтобы радиусы его центров
+     * в пределах ограничения были точными
+     *
+     * @param visit Вызывается как visit(центр в неявной строке, радиус)
+     */
+    template <typename Visitor>
+    void scan(const unsigned char* data, size_t size, size_t maxLength, size_t chunkSize, Visitor visit) {
+        if (maxLength == 0) {
+            throw std::invalid_argument("Максимальная длина палиндрома должна быть больше 0");
+        }
+
+        // Ограничение для центров-символов (нечетные длины) и центров-разделителей (четные)
+        size_t oddCap = (maxLength % 2 == 1) ? maxLength : maxLength - 1;
+        size_t evenCap = (maxLength % 2 == 0) ? maxLength : maxLength - 1;
+        size_t margin = maxLength / 2 + 1;
+
+        size_t chunkStart = 0;
+        do {
+            size_t chunkEnd = chunkStart + std::min(chunkSize, size - chunkStart);
+            size_t sliceStart = chunkStart - std::min(chunkStart, margin);
+            size_t sliceEnd = chunkEnd + std::min(size - chunkEnd, margin);
+
+            computeRadii(data + sliceStart, sliceEnd - sliceStart);
+
+            size_t base = 2 * sliceStart;
+            size_t first = 2 * chunkStart;
+            size_t last = (chunkEnd == size) ? 2 * size + 1 : 2 * chunkEnd;
+            for (size_t i = first; i < last; ++i) {
+                size_t cap = (i & 1) ? oddCap : evenCap;
+                visit(i, std::min(radii_[i - base], cap));
+            }
+
+            chunkStart = chunkEnd;
+        } while (chunkStart < size);
+    }
+
+    PalindromeMatch longestImpl(const unsigned char* data, size_t size, size_t maxLength, size_t chunkSize) {
+        PalindromeMatch best{0, 0};
+        scan(data, size, maxLength, chunkSize, [&best](size_t center, size_t radius) {
+            if (radius > best.length) {
+                best.offset = (center - radius) / 2;
+                best.length = radius;
+            }
+        });
+        return best;
+    }
+
+    unsigned long long countImpl(const unsigned char* data, size_t size, size_t maxLength, size_t chunkSize) {
+        unsigned long long total = 0;
+        scan(data, size, maxLength, chunkSize, [&total](size_t, size_t radius) {
+            // Радиус r в неявной строке соответствует (r + 1) / 2 вложенным палиндромам
+            total += (radius + 1) / 2;
+        });
+        return total;
+    }
+
+    static const unsigned char* bytes(std::string_view text) {
+        return reinterpret_cast<const unsigned char*>(text.data());
+    }
+
+public:
+    /**
+     * @param streamChunkSize Размер окна в байтах для потокового режима
+     */
+    explicit PalindromicSubstrings(size_t streamChunkSize = kDefaultStreamChunkSize)
+        : streamChunkSize_(streamChunkSize > 0 ? streamChunkSize : 1) {}
+
+    /**
+     * Самая длинная палиндромная подстрока (первая из самых длинных)
+     *
+     * @param text Текст для поиска
+     * @return Смещение и длина подстроки; для пустого текста длина 0
+     */
+    PalindromeMatch longest(std::string_view text) {
+        return longest(bytes(text), text.size());
+    }
+
+    PalindromeMatch longest(const unsigned char* data, size_t size) {
+        return longestImpl(data, size, std::max<size_t>(size, 1), std::max<size_t>(size, 1));
+    }
+
+    /**
+     * Общее количество палиндромных подстрок с учетом позиций
+     * (например, в "aaa" их 6: три "a", две "aa" и одна "aaa")
+     */
+    unsigned long long count(std::string_view text) {
+        return count(bytes(text), text.size());
+    }
+
+    unsigned long long count(const unsigned char* data, size_t size) {
+        return countImpl(data, size, std::max<size_t>(size, 1), std::max<size_t>(size, 1));
+    }
+
+    /**
+     * Потоковый поиск самой длинной палиндромной подстроки в файле.
+     * Рассматриваются палиндромы длиной не больше maxLength
+     *
+     * @param path Путь к файлу
+     * @param maxLength Максимальная длина палиндрома
+     * @throws std::runtime_error если файл не удалось отобразить в память
+     * @throws std::invalid_argument если maxLength равно 0
+     */
+    PalindromeMatch longestInFile(const std::string& path, size_t maxLength) {
+        MappedFile file(path);
+        return longestImpl(reinterpret_cast<const unsigned char*>(file.data()), file.size(),
+                           maxLength, streamChunkSize_);
+    }
+
+    /**
+     * Потоковый подсчет палиндромных подстрок длиной не больше maxLength в файле
+     *
+     * @param path Путь к файлу
+     * @param maxLength Максимальная длина учитываемого палиндрома
+     * @throws std::runtime_error если файл не удалось отобразить в память
+     * @throws std::invalid_argument если maxLength равно 0
+     */
+    unsigned long long countInFile(const std::string& path, size_t maxLength) {
+        MappedFile file(path);
+        return countImpl(reinterpret_cast<const unsigned char*>(file.data()), file.size(),
+                         maxLength, streamChunkSize_);
+    }
+};
@@ -0,0 +1,272 @@
+// perf_counters.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Аппаратные счетчики производительности для замеров (Linux, perf_event_open).
+ * BenchmarkSuite снимает их вокруг каждого повторения, тесты производительности - вокруг операций.
+ *
+ * Каждый счетчик открывается отдельно и только для текущего потока в режиме пользователя,
+ * поэтому достаточно kernel.perf_event_paranoid <= 2. Если счетчик не поддерживается
+ * процессором (например, в виртуальной машине) или запрещен, он помечается недоступным,
+ * а остальные продолжают работать; время выполнения измеряется как и раньше.
+ *
+ * Пример:
+ *   PerfCounters counters;
+ *   auto result = counters.measure([&] { list.reverse(); });
+ *   PerfCounters::report(std::cout, "Разворот", result, list.size());
+ */
+class PerfCounters {
+public:
+    enum Counter {
+        kCycles,
+        kInstructions,
+        kL1DataMisses,
+        kLastLevelMisses,
+        kDataTlbMisses,
+        kBranchMisses,
+        kCounterCount
+    };
+
+    /**
+     * Значения счетчиков за одно измерение
+     */
+    struct Result {
+        bool available[kCounterCount] = {};
+        uint64_t values[kCounterCount] = {};
+
+        [[nodiscard]] bool has(Counter counter) const {
+            return available[counter];
+        }
+
+        /**
+         * Доступен ли хотя бы один счетчик
+         */
+        [[nodiscard]] bool any() const {
+            for (bool counterAvailable : available) {
+                if (counterAvailable) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Добавление следующего измерения: значения суммируются, счетчик остается
+         * доступным, только если он был доступен во всех измерениях
+         *
+         * @param first Это первое измерение суммы
+         */
+        void accumulate(const Result& other, bool first) {
+            for (int i = 0; i < kCounterCount; ++i) {
+                available[i] = other.available[i] && (first || available[i]);
+                values[i] += other.values[i];
+            }
+        }
+
+        /**
+         * Инструкции за такт; 0, если циклы или инструкции недоступны
+         */
+        [[nodiscard]] double ipc() const {
+            if (!has(kCycles) || !has(kInstructions) || values[kCycles] == 0) {
+                return 0.0;
+            }
+            return static_cast<double>(values[kInstructions]) / static_cast<double>(values[kCycles]);
+        }
+
+        /**
+         * Значение счетчика в пересчете на один обработанный элемент
+         */
+        [[nodiscard]] double perElement(Counter counter, size_t elements) const {
+            return elements > 0 ? static_cast<double>(values[counter]) / static_cast<double>(elements) : 0.0;
+        }
+    };
+
+private:
+    int descriptors_[kCounterCount];
+
+#ifdef __linux__
+    static void describe(Counter counter, perf_event_attr& attr) {
+        auto cache = [](uint64_t cacheId, uint64_t operation, uint64_t result) {
+            return cacheId | (operation << 8) | (result << 16);
+        };
+        switch (counter) {
+            case kCycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case kInstructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case kL1DataMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+            case kLastLevelMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case kDataTlbMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+            case kBranchMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            default:
+                break;
+        }
+    }
+
+    static int open(Counter counter) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        describe(counter, attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Время работы нужно для поправки, если ядро мультиплексирует счетчики
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+        for (int i = 0; i < kCounterCount; ++i) {
+#ifdef __linux__
+            descriptors_[i] = open(static_cast<Counter>(i));
+#else
+            descriptors_[i] = -1;
+#endif
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int descriptor : descriptors_) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Доступен ли хотя бы один счетчик
+     */
+    [[nodiscard]] bool isAvailable() const {
+        for (int descriptor : descriptors_) {
+            if (descriptor >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void start() {
+#ifdef __linux__
+        for (int descriptor : descriptors_) {
+            if (descriptor >= 0) {
+                ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    Result stop() {
+        Result result;
+#ifdef __linux__
+        for (int descriptor : descriptors_) {
+            if (descriptor >= 0) {
+                ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (int i = 0; i < kCounterCount; ++i) {
+            uint64_t data[3] = {0, 0, 0};  // значение, время включения, время работы
+            if (descriptors_[i] < 0 || read(descriptors_[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+                continue;
+            }
+            result.available[i] = true;
+            result.values[i] = data[2] < data[1]
+                ? static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2])
+                : data[0];
+        }
+#endif
+        return result;
+    }
+
+    /**
+     * Значения счетчиков за время выполнения action()
+     */
+    template <typename Action>
+    Result measure(Action&& action) {
+        start();
+        action();
+        return stop();
+    }
+
+    /**
+     * Имя счетчика латиницей для машиночитаемого вывода (JSON замеров)
+     */
+    static const char* key(Counter counter) {
+        static const char* const kKeys[kCounterCount] = {
+            "cycles", "instructions", "l1d_misses", "llc_misses", "dtlb_misses", "branch_misses"
+        };
+        return kKeys[counter];
+    }
+
+    /**
+     * Вывод IPC и промахов на элемент; недоступные счетчики отмечаются "н/д"
+     */
+    static void report(std::ostream& out, const std::string& name, const Result& result, size_t elements) {
+        static const char* const kNames[kCounterCount] = {
+            "циклы", "инструкции", "промахи L1D", "промахи LLC", "промахи dTLB", "ошибки предсказания переходов"
+        };
+
+        out << name << ": ";
+        if (!result.any()) {
+            out << "аппаратные счетчики недоступны (perf_event_open)\n";
+            return;
+        }
+
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+        if (result.has(kCycles) && result.has(kInstructions)) {
+            out << "IPC " << result.ipc() << ", ";
+        }
+        out << "на элемент:";
+        for (int i = 0; i < kCounterCount; ++i) {
+            out << (i == 0 ? " " : ", ") << kNames[i] << " ";
+            if (result.has(static_cast<Counter>(i))) {
+                out << result.perElement(static_cast<Counter>(i), elements);
+            } else {
+                out << "н/д";
+            }
+        }
+        out << "\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+};
@@ -0,0 +1,202 @@
+// persistent_list.h
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Неизменяемый (персистентный) односвязный список.
+ * Каждая операция возвращает новую версию списка, разделяющую с исходной
+ * все узлы, которые не нужно менять. Копирование версии (снимок) стоит O(1)
+ */
+template <typename T>
+class PersistentList {
+public:
+    struct Node {
+        T data;
+        std::shared_ptr<const Node> next;
+
+        Node(T value, std::shared_ptr<const Node> nextNode)
+            : data(std::move(value)), next(std::move(nextNode)) {}
+    };
+
+private:
+    std::shared_ptr<const Node> head_;
+    size_t size_;
+
+    PersistentList(std::shared_ptr<const Node> head, size_t size)
+        : head_(std::move(head)), size_(size) {}
+
+    /**
+     * Итеративное освобождение цепочки узлов, которыми владеет только эта версия.
+     * Как только встречается узел, разделяемый с другой версией, останавливаемся
+     */
+    void releaseNodes() {
+        while (head_ && head_.use_count() == 1) {
+            std::shared_ptr<const Node> next = head_->next;
+            head_ = std::move(next);
+        }
+        head_ = nullptr;
+    }
+
+    void swap(PersistentList& other) noexcept {
+        head_.swap(other.head_);
+        std::swap(size_, other.size_);
+    }
+
+public:
+    PersistentList() : head_(nullptr), size_(0) {}
+
+    /**
+     * Создание списка из вектора значений
+     */
+    explicit PersistentList(const std::vector<T>& values) : head_(nullptr), size_(0) {
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            head_ = std::make_shared<const Node>(*it, std::move(head_));
+        }
+        size_ = values.size();
+    }
+
+    PersistentList(const PersistentList&) = default;
+    PersistentList(PersistentList&&) noexcept = default;
+
+    /**
+     * Присваивание через временную версию: прежняя цепочка уходит во временный
+     * объект и освобождается итеративно в его деструкторе, а не рекурсивными
+     * деструкторами shared_ptr
+     */
+    PersistentList& operator=(const PersistentList& other) {
+        PersistentList copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    PersistentList& operator=(PersistentList&& other) noexcept {
+        PersistentList moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~PersistentList() {
+        releaseNodes();
+    }
+
+    /**
+     * Новая версия с элементом в начале. O(1), хвост разделяется с текущей версией
+     */
+    [[nodiscard]] PersistentList pushFront(T value) const {
+        return PersistentList(std::make_shared<const Node>(std::move(value), head_), size_ + 1);
+    }
+
+    /**
+     * Новая версия без первого элемента. O(1), без выделения памяти
+     *
+     * @throws std::out_of_range если список пуст
+     */
+    [[nodiscard]] PersistentList popFront() const {
+        if (!head_) {
+            throw std::out_of_range("Удаление из пустого списка");
+        }
+        return PersistentList(head_->next, size_ - 1);
+    }
+
+    /**
+     * Первый элемент списка
+     *
+     * @throws std::out_of_range если список пуст
+     */
+    [[nodiscard]] const T& front() const {
+        if (!head_) {
+            throw std::out_of_range("Обращение к элементу пустого списка");
+        }
+        return head_->data;
+    }
+
+    /**
+     * Новая развернутая версия. Все узлы развернутого списка новые,
+     * так как в неизменяемом списке менять указатели next нельзя
+     */
+    [[nodiscard]] PersistentList reverse() const {
+        std::shared_ptr<const Node> result;
+        for (const Node* current = head_.get(); current; current = current->next.get()) {
+            result = std::make_shared<const Node>(current->data, std::move(result));
+        }
+        return PersistentList(std::move(result), size_);
+    }
+
+    /**
+     * Новая версия, в которой за элементами текущей следуют элементы other.
+     * Копируются только узлы текущей версии, список other разделяется целиком
+     */
+    [[nodiscard]] PersistentList append(const PersistentList& other) const {
+        if (!head_) {
+            return other;
+        }
+        if (!other.head_) {
+            return *this;
+        }
+
+        // Копируем узлы текущей версии; пока копия не опубликована, ее можно достраивать
+        auto first = std::make_shared<Node>(head_->data, nullptr);
+        Node* tail = first.get();
+        for (const Node* current = head_->next.get(); current; current = current->next.get()) {
+            auto node = std::make_shared<Node>(current->data, nullptr);
+            Node* raw = node.get();
+            tail->next = std::move(node);
+            tail = raw;
+        }
+        tail->next = other.head_;
+
+        return PersistentList(std::move(first), size_ + other.size_);
+    }
+
+    /**
+     * Получение размера списка
+     */
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    /**
+     * Проверка пустой ли список
+     */
+    [[nodiscard]] bool isEmpty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * Получение указателя на голову списка
+     */
+    [[nodiscard]] std::shared_ptr<const Node> getHead() const {
+        return head_;
+    }
+
+    /**
+     * Обход элементов по порядку. Указатели на узлы не копируются,
+     * поэтому счетчики ссылок общих узлов не меняются
+     *
+     * @param function Вызывается для каждого элемента как function(const T&)
+     */
+    template <typename Function>
+    void forEach(Function function) const {
+        for (const Node* current = head_.get(); current; current = current->next.get()) {
+            function(current->data);
+        }
+    }
+
+    /**
+     * Преобразование списка в вектор
+     */
+    [[nodiscard]] std::vector<T> toVector() const {
+        std::vector<T> result;
+        result.reserve(size_);
+
+        for (const Node* current = head_.get(); current; current = current->next.get()) {
+            result.push_back(current->data);
+        }
+
+        return result;
+    }
+};
@@ -0,0 +1,445 @@
+// pipeline.h
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Ограниченная очередь без блокировок для одного писателя и одного читателя.
+ * Кольцевой буфер размера 2^k; писатель двигает только tail_, читатель - только head_.
+ * Элементы не копируются, а обмениваются со слотами: пустые буферы пакетов
+ * возвращаются писателю, и в установившемся режиме память не выделяется
+ */
+template <typename T>
+class SpscQueue {
+private:
+    std::vector<T> slots_;
+    size_t mask_;
+    // Индексы на разных кэш-линиях, чтобы писатель и читатель не мешали друг другу
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+
+public:
+    /**
+     * @param capacity Вместимость, округляется вверх до степени двойки
+     */
+    explicit SpscQueue(size_t capacity) : head_(0), tail_(0) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    /**
+     * Попытка добавить элемент; при успехе value обменивается с содержимым слота
+     *
+     * @return false, если очередь заполнена
+     */
+    bool tryPush(T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+            return false;
+        }
+        std::swap(slots_[tail & mask_], value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Попытка извлечь элемент; прежнее значение value остается в слоте
+     *
+     * @return false, если очередь пуста
+     */
+    bool tryPop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        std::swap(slots_[head & mask_], value);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/**
+ * Канал между двумя стадиями: очередь пакетов, флаг закрытия и общий флаг отмены
+ */
+template <typename T>
+class Channel {
+private:
+    SpscQueue<std::vector<T>> queue_;
+    std::atomic<bool> closed_;
+    std::atomic<bool> connected_;
+    const std::atomic<bool>& cancelled_;
+
+    static void backoff(unsigned& attempt) {
+        // Короткое ожидание активное, дальше отдаем процессор, а при долгом простое
+        // засыпаем на растущее время (до 1 мс), чтобы ждущая стадия не занимала ядро
+        ++attempt;
+        if (attempt <= 64) {
+            return;
+        }
+        if (attempt <= 128) {
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(1u << std::min(attempt - 128, 10u)));
+    }
+
+public:
+    Channel(size_t capacity, const std::atomic<bool>& cancelled)
+        : queue_(capacity), closed_(false), connected_(false), cancelled_(cancelled) {}
+
+    /**
+     * Отправка пакета; при заполненной очереди писатель ждет (обратное давление)
+     *
+     * @return false, если конвейер отменен
+     */
+    bool push(std::vector<T>& batch) {
+        unsigned attempt = 0;
+        while (!queue_.tryPush(batch)) {
+            if (cancelled_.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            backoff(attempt);
+        }
+        return true;
+    }
+
+    /**
+     * Получение пакета
+     *
+     * @return false, если канал закрыт и пуст или конвейер отменен
+     */
+    bool pop(std::vector<T>& batch) {
+        // Обработанные элементы освобождаются сразу, в очередь уходит пустой буфер
+        batch.clear();
+        unsigned attempt = 0;
+        while (!queue_.tryPop(batch)) {
+            if (closed_.load(std::memory_order_acquire)) {
+                // Последний пакет мог прийти между двумя проверками
+                return queue_.tryPop(batch);
+            }
+            if (cancelled_.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            backoff(attempt);
+        }
+        return true;
+    }
+
+    void close() {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Отметка о подключении читателя; у канала может быть только один читатель
+     *
+     * @throws std::logic_error если читатель уже подключен
+     */
+    void connect() {
+        if (connected_.exchange(true)) {
+            throw std::logic_error("К выходу стадии уже подключена следующая стадия");
+        }
+    }
+};
+
+/**
+ * Накопитель пакета: стадия передает элементы по одному,
+ * а в канал они уходят пакетами по batchSize
+ */
+template <typename T>
+class Emitter {
+private:
+    Channel<T>& channel_;
+    std::vector<T> batch_;
+    size_t batchSize_;
+    bool open_;
+
+public:
+    Emitter(Channel<T>& channel, size_t batchSize) : channel_(channel), batchSize_(batchSize), open_(true) {
+        batch_.reserve(batchSize_);
+    }
+
+    /**
+     * Передача элемента следующей стадии
+     *
+     * @return false, если конвейер отменен и продолжать бессмысленно
+     */
+    bool operator()(T value) {
+        batch_.push_back(std::move(value));
+        if (batch_.size() >= batchSize_) {
+            return flush();
+        }
+        return open_;
+    }
+
+    /**
+     * Отправка неполного пакета
+     */
+    bool flush() {
+        if (batch_.empty()) {
+            return open_;
+        }
+        // После отмены элементы отбрасываются, чтобы пакет не рос без ограничения
+        if (open_) {
+            open_ = channel_.push(batch_);
+        }
+        // После обмена в batch_ лежит пустой буфер, уже прошедший через следующую стадию
+        batch_.clear();
+        batch_.reserve(batchSize_);
+        return open_;
+    }
+};
+
+class Pipeline;
+
+/**
+ * Выход стадии конвейера, к которому подключается следующая стадия.
+ * Каждый выход можно подключить только один раз
+ */
+template <typename T>
+class Stream {
+private:
+    Pipeline* pipeline_;
+    std::shared_ptr<Channel<T>> channel_;
+
+public:
+    Stream(Pipeline* pipeline, std::shared_ptr<Channel<T>> channel)
+        : pipeline_(pipeline), channel_(std::move(channel)) {}
+
+    /**
+     * Стадия преобразования: transform(const T&, Emitter<U>&) может передать
+     * дальше любое количество элементов
+     */
+    template <typename U, typename Transform>
+    Stream<U> then(Transform transform);
+
+    /**
+     * Стадия отображения каждого элемента
+     */
+    template <typename Function>
+    auto map(Function function) -> Stream<std::decay_t<decltype(function(std::declval<const T&>()))>>;
+
+    /**
+     * Стадия фильтрации по предикату
+     */
+    template <typename Predicate>
+    Stream<T> filter(Predicate predicate);
+
+    /**
+     * Завершающая стадия: consume(T) вызывается для каждого элемента в отдельном потоке
+     */
+    template <typename Consumer>
+    void forEach(Consumer consume);
+};
+
+/**
+ * Потоковый конвейер: каждая стадия работает в своем потоке, соседние
+ * стадии связаны ограниченными очередями без блокировок, элементы
+ * передаются пакетами. Если следующая стадия не успевает, очередь
+ * заполняется и предыдущая ждет (обратное давление).
+ *
+ * Пример:
+ *   Pipeline pipeline;
+ *   pipeline.source<int>(producer).filter(predicate).forEach(consumer);
+ *   pipeline.wait();
+ *
+ * Исключение в любой стадии отменяет весь конвейер и пробрасывается из wait()
+ */
+class Pipeline {
+public:
+    static constexpr size_t kDefaultBatchSize = 256;
+    static constexpr size_t kDefaultQueueCapacity = 16;
+
+private:
+    size_t batchSize_;
+    size_t queueCapacity_;
+    std::vector<std::thread> threads_;
+    // Число выходов стадий, к которым еще не подключена следующая стадия
+    size_t openOutputs_;
+    std::atomic<bool> cancelled_;
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+
+    template <typename T>
+    friend class Stream;
+
+    template <typename T>
+    std::shared_ptr<Channel<T>> makeChannel() {
+        auto channel = std::make_shared<Channel<T>>(queueCapacity_, cancelled_);
+        ++openOutputs_;
+        return channel;
+    }
+    
+    template <typename T>
+    void connect(Channel<T>& input) {
+        input.connect();
+        --openOutputs_;
+    }
+
+    void fail(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (!error_) {
+            error_ = error;
+        }
+        cancelled_.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Запуск стадии в отдельном потоке; выход стадии закрывается при любом исходе
+     */
+    template <typename T, typename Body>
+    void launch(std::shared_ptr<Channel<T>> output, Body body) {
+        threads_.emplace_back([this, output, body]() mutable {
+            try {
+                body();
+            } catch (...) {
+                fail(std::current_exception());
+            }
+            if (output) {
+                output->close();
+            }
+        });
+    }
+
+    template <typename In, typename Out, typename Transform>
+    Stream<Out> addStage(std::shared_ptr<Channel<In>> input, Transform transform) {
+        connect(*input);
+        auto output = makeChannel<Out>();
+        size_t batchSize = batchSize_;
+        launch(output, [input, output, transform, batchSize]() mutable {
+            Emitter<Out> emit(*output, batchSize);
+            std::vector<In> batch;
+            while (input->pop(batch)) {
+                for (const auto& value : batch) {
+                    transform(value, emit);
+                }
+            }
+            emit.flush();
+        });
+        return Stream<Out>(this, output);
+    }
+
+    template <typename In, typename Consumer>
+    void addSink(std::shared_ptr<Channel<In>> input, Consumer consume) {
+        connect(*input);
+        launch(std::shared_ptr<Channel<In>>(), [input, consume]() mutable {
+            std::vector<In> batch;
+            while (input->pop(batch)) {
+                for (auto& value : batch) {
+                    consume(std::move(value));
+                }
+            }
+        });
+    }
+
+public:
+    /**
+     * @param batchSize Количество элементов в пакете
+     * @param queueCapacity Количество пакетов в очереди между стадиями
+     */
+    explicit Pipeline(size_t batchSize = kDefaultBatchSize, size_t queueCapacity = kDefaultQueueCapacity)
+        : batchSize_(batchSize > 0 ? batchSize : 1),
+          queueCapacity_(queueCapacity > 0 ? queueCapacity : 1),
+          openOutputs_(0),
+          cancelled_(false) {}
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * Незавершенный конвейер отменяется, чтобы не ждать стадии, которым некуда писать
+     */
+    ~Pipeline() {
+        if (!threads_.empty()) {
+            cancelled_.store(true, std::memory_order_relaxed);
+            for (auto& thread : threads_) {
+                thread.join();
+            }
+        }
+    }
+
+    /**
+     * Начальная стадия: produce(Emitter<T>&) передает элементы через emit(value)
+     * и может остановиться, если emit вернул false
+     */
+    template <typename T, typename Producer>
+    Stream<T> source(Producer produce) {
+        auto output = makeChannel<T>();
+        size_t batchSize = batchSize_;
+        launch(output, [output, produce, batchSize]() mutable {
+            Emitter<T> emit(*output, batchSize);
+            produce(emit);
+            emit.flush();
+        });
+        return Stream<T>(this, output);
+    }
+
+    /**
+     * Ожидание завершения всех стадий. Стадия, выход которой никуда не подключен,
+     * заполнила бы очередь и ждала бы вечно, поэтому такой конвейер отменяется
+     *
+     * @throws std::logic_error если выход какой-либо стадии не подключен
+     * @throws Первое исключение, возникшее в стадиях
+     */
+    void wait() {
+        if (openOutputs_ > 0) {
+            openOutputs_ = 0;
+            fail(std::make_exception_ptr(std::logic_error("Выход стадии конвейера не подключен")));
+        }
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
+
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+template <typename T>
+template <typename U, typename Transform>
+Stream<U> Stream<T>::then(Transform transform) {
+    return pipeline_->addStage<T, U>(channel_, std::move(transform));
+}
+
+template <typename T>
+template <typename Function>
+auto Stream<T>::map(Function function) -> Stream<std::decay_t<decltype(function(std::declval<const T&>()))>> {
+    using U = std::decay_t<decltype(function(std::declval<const T&>()))>;
+    return then<U>([function](const T& value, Emitter<U>& emit) mutable {
+        emit(function(value));
+    });
+}
+
+template <typename T>
+template <typename Predicate>
+Stream<T> Stream<T>::filter(Predicate predicate) {
+    return then<T>([predicate](const T& value, Emitter<T>& emit) mutable {
+        if (predicate(value)) {
+            emit(value);
+        }
+    });
+}
+
+template <typename T>
+template <typename Consumer>
+void Stream<T>::forEach(Consumer consume) {
+    pipeline_->addSink<T>(channel_, std::move(consume));
+}
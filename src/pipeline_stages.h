@@ -0,0 +1,83 @@
+// pipeline_stages.h
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "fibonacci.h"
+#include "linked_list.h"
+#include "palindrome.h"
+#include "pipeline.h"
+
+/**
+ * Стадии конвейера на основе трех задач проекта.
+ *
+ * Пример: палиндромные числа Фибоначчи в развернутом списке
+ *   LinkedList<unsigned long long> list;
+ *   Pipeline pipeline;
+ *   pipeline.source<unsigned long long>(PipelineStages::fibonacci(94))
+ *           .filter(PipelineStages::palindromes())
+ *           .forEach(PipelineStages::appendTo(list));
+ *   pipeline.wait();
+ *   list.reverse();
+ */
+class PipelineStages {
+public:
+    /**
+     * Источник первых count чисел Фибоначчи. Числа вычисляются по одному
+     * и сразу уходят дальше, весь префикс в памяти не хранится
+     *
+     * @throws std::invalid_argument (в wait()) если count равно 0
+     * @throws std::overflow_error (в wait()) если число не помещается в unsigned long long
+     */
+    static auto fibonacci(unsigned int count) {
+        return [count](Emitter<unsigned long long>& emit) {
+            if (count == 0) {
+                throw std::invalid_argument("Количество чисел должно быть больше 0");
+            }
+            unsigned long long previous = 0;
+            unsigned long long current = 1;
+            for (unsigned int i = 0; i < count; ++i) {
+                if (!emit(previous)) {
+                    return;
+                }
+                // F(i + 2) нужно, только если оно тоже будет передано
+                unsigned long long next = i + 2 < count ? CheckedArithmetic::add(previous, current) : 0;
+                previous = current;
+                current = next;
+            }
+        };
+    }
+
+    /**
+     * Фильтр палиндромов выбранным методом PalindromeChecker.
+     * Числа больше LLONG_MAX проверяются строковым способом
+     */
+    template <typename Method = PalindromeChecker::DigitTableMethod>
+    static auto palindromes() {
+        return [](unsigned long long value) {
+            if (value <= static_cast<unsigned long long>(LLONG_MAX)) {
+                return PalindromeChecker::isPalindromeWith<Method>(static_cast<long long>(value));
+            }
+            std::string digits = std::to_string(value);
+            return std::equal(digits.begin(), digits.begin() + digits.size() / 2, digits.rbegin());
+        };
+    }
+
+    /**
+     * Завершающая стадия: добавление элементов в конец списка за O(1) на элемент
+     * (см. LinkedList::Appender). Список должен существовать и не меняться
+     * до завершения wait()
+     *
+     * @param blockSize Количество узлов в блоке арены
+     */
+    template <typename T>
+    static auto appendTo(LinkedList<T>& list, size_t blockSize = 4096) {
+        return [append = list.appender(blockSize)](T value) mutable {
+            append(std::move(value));
+        };
+    }
+};
@@ -0,0 +1,261 @@
+// rcu_list.h
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "persistent_list.h"
+
+/**
+ * Список для многих читателей и редкого писателя в стиле RCU (read-copy-update).
+ *
+ * Текущая версия - неизменяемый PersistentList, на который указывает атомарный
+ * указатель. Писатель не меняет опубликованную версию: он строит новую рядом
+ * (pushFront разделяет с прежней весь хвост, reverse строит новые узлы)
+ * и публикует ее одной атомарной заменой указателя. Читатели не берут блокировок
+ * и не трогают счетчики ссылок: вход в чтение - запись эпохи в свою ячейку
+ * и чтение указателя, то есть фиксированное число шагов (wait-free).
+ *
+ * Прежние версии освобождаются по эпохам: при замене версия помечается
+ * текущей глобальной эпохой r, эпоха увеличивается, и версия удаляется,
+ * когда ни один читатель не находится в чтении, начатом в эпоху r или раньше.
+ * Узлы, общие с более новыми версиями, при этом не освобождаются:
+ * ими владеют shared_ptr внутри PersistentList
+ *
+ * @tparam T Тип элементов
+ */
+template <typename T>
+class RcuList {
+public:
+    // Наибольшее число одновременно зарегистрированных читателей
+    static constexpr size_t kMaxReaders = 128;
+
+private:
+    // Эпоха ячейки вне чтения
+    static constexpr uint64_t kIdle = 0;
+
+    // Ячейка читателя занимает собственную строку кэша, чтобы читатели не мешали друг другу
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{kIdle};
+        std::atomic<bool> used{false};
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        const PersistentList<T>* version;
+    };
+
+    std::atomic<const PersistentList<T>*> current_;
+    std::atomic<uint64_t> epoch_;
+    std::unique_ptr<Slot[]> slots_;
+    std::mutex writerMutex_;
+    std::vector<Retired> retired_;
+
+    /**
+     * Публикация новой версии и освобождение версий, которые никто не читает.
+     * Вызывается под writerMutex_
+     */
+    void publish(const PersistentList<T>* version) {
+        retired_.reserve(retired_.size() + 1);
+        const PersistentList<T>* previous = current_.exchange(version);
+        // Читатель, успевший прочитать previous, записал эпоху не больше retireEpoch
+        uint64_t retireEpoch = epoch_.fetch_add(1);
+        retired_.push_back(Retired{retireEpoch, previous});
+        reclaimRetired();
+    }
+
+    void reclaimRetired() {
+        uint64_t oldest = UINT64_MAX;
+        for (size_t i = 0; i < kMaxReaders; ++i) {
+            uint64_t epoch = slots_[i].epoch.load();
+            if (epoch != kIdle) {
+                oldest = std::min(oldest, epoch);
+            }
+        }
+
+        auto kept = std::remove_if(retired_.begin(), retired_.end(), [oldest](const Retired& entry) {
+            if (entry.epoch < oldest) {
+                delete entry.version;
+                return true;
+            }
+            return false;
+        });
+        retired_.erase(kept, retired_.end());
+    }
+
+    template <typename Update>
+    void modify(Update update) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        const PersistentList<T>* current = current_.load(std::memory_order_relaxed);
+        publish(new PersistentList<T>(update(*current)));
+    }
+
+public:
+    /**
+     * Зарегистрированный читатель. Объект принадлежит одному потоку и должен
+     * быть уничтожен раньше списка; пока он жив, он занимает ячейку читателя
+     */
+    class Reader {
+    private:
+        RcuList* list_;
+        Slot* slot_;
+
+        friend class RcuList;
+
+        Reader(RcuList* list, Slot* slot) : list_(list), slot_(slot) {}
+
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        Reader(Reader&& other) noexcept : list_(other.list_), slot_(other.slot_) {
+            other.slot_ = nullptr;
+        }
+
+        Reader& operator=(Reader&&) = delete;
+
+        ~Reader() {
+            if (slot_) {
+                slot_->used.store(false, std::memory_order_release);
+            }
+        }
+
+        /**
+         * Чтение текущей версии. Версия, переданная в visitor, не меняется
+         * и не освобождается, пока visitor не вернет управление
+         *
+         * @param visitor Вызывается как visitor(const PersistentList<T>&); для обхода
+         *                лучше PersistentList::forEach, getHead() меняет общий счетчик ссылок
+         * @return Результат visitor
+         */
+        template <typename Visitor>
+        auto read(Visitor visitor) const {
+            // Сначала эпоха, потом указатель: писатель, увидевший эпоху idle,
+            // уже опубликовал новую версию, и читатель прочитает именно ее
+            slot_->epoch.store(list_->epoch_.load());
+            const PersistentList<T>* version = list_->current_.load();
+
+            struct Exit {
+                Slot* slot;
+                ~Exit() {
+                    slot->epoch.store(kIdle, std::memory_order_release);
+                }
+            } exit{slot_};
+
+            return visitor(*version);
+        }
+
+        /**
+         * Обход элементов текущей версии
+         *
+         * @param function Вызывается для каждого элемента как function(const T&)
+         * @return Число пройденных элементов
+         */
+        template <typename Function>
+        size_t forEach(Function function) const {
+            return read([&function](const PersistentList<T>& version) {
+                version.forEach([&function](const T& value) {
+                    function(value);
+                });
+                return version.size();
+            });
+        }
+    };
+
+    RcuList() : current_(new PersistentList<T>()), epoch_(1), slots_(new Slot[kMaxReaders]) {}
+
+    /**
+     * Создание списка из вектора значений
+     */
+    explicit RcuList(const std::vector<T>& values)
+        : current_(new PersistentList<T>(values)), epoch_(1), slots_(new Slot[kMaxReaders]) {}
+
+    RcuList(const RcuList&) = delete;
+    RcuList& operator=(const RcuList&) = delete;
+
+    /**
+     * Уничтожение списка; все читатели к этому моменту должны быть уничтожены
+     */
+    ~RcuList() {
+        for (const auto& entry : retired_) {
+            delete entry.version;
+        }
+        delete current_.load();
+    }
+
+    /**
+     * Регистрация читателя: поиск свободной ячейки без блокировок
+     *
+     * @throws std::runtime_error если заняты все kMaxReaders ячеек
+     */
+    [[nodiscard]] Reader reader() {
+        for (size_t i = 0; i < kMaxReaders; ++i) {
+            bool expected = false;
+            if (!slots_[i].used.load(std::memory_order_relaxed) &&
+                slots_[i].used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return Reader(this, &slots_[i]);
+            }
+        }
+        throw std::runtime_error("Превышено число одновременных читателей списка");
+    }
+
+    /**
+     * Публикация версии с элементом в начале: O(1), хвост разделяется с прежней версией
+     */
+    void pushFront(T value) {
+        modify([&value](const PersistentList<T>& current) {
+            return current.pushFront(std::move(value));
+        });
+    }
+
+    /**
+     * Публикация развернутой версии: O(n), узлы строятся заново,
+     * читатели прежней версии продолжают обход без изменений
+     */
+    void reverse() {
+        modify([](const PersistentList<T>& current) {
+            return current.reverse();
+        });
+    }
+
+    /**
+     * Публикация произвольного изменения
+     *
+     * @param update Вызывается под блокировкой писателей как update(const PersistentList<T>&)
+     *               и возвращает новую версию
+     */
+    template <typename Update>
+    void update(Update update) {
+        modify(std::move(update));
+    }
+
+    /**
+     * Копия текущей версии для писателя (O(1), узлы разделяются)
+     */
+    [[nodiscard]] PersistentList<T> snapshot() {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        return *current_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Повторная попытка освободить прежние версии, например после долгого чтения
+     */
+    void reclaim() {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        reclaimRetired();
+    }
+
+    /**
+     * Число прежних версий, которые еще могут читаться и ждут освобождения
+     */
+    [[nodiscard]] size_t pendingReclamation() {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        return retired_.size();
+    }
+};
@@ -0,0 +1,317 @@
+// trace.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Трассировка вызовов в формате Chrome Trace (открывается в chrome://tracing и Perfetto).
+ *
+ * Каждый поток пишет события в собственный кольцевой буфер без блокировок,
+ * мьютекс берется только при регистрации буфера потока и при завершении потока.
+ * Буфер завершившегося потока хранит события до экспорта или clear(), после
+ * чего отдается следующему новому потоку. Время берется счетчиком тактов
+ * процессора и переводится в микросекунды только при экспорте. Выключенная
+ * трассировка стоит одной проверки флага на участок.
+ *
+ * Включается переменной окружения ALGORITHMS_TRACE=<файл> или вызовом enable()
+ */
+class Tracer {
+public:
+    // Число событий в буфере одного потока; при переполнении старые события затираются
+    static constexpr size_t kBufferCapacity = 1 << 16;
+    // Сколько буферов завершившихся потоков хранится до экспорта; сверх этого
+    // новый поток забирает самый старый из них вместе с событиями
+    static constexpr size_t kMaxRetiredBuffers = 64;
+
+    struct Event {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+private:
+    struct ThreadBuffer {
+        std::vector<Event> events;
+        std::atomic<uint64_t> written;
+        unsigned threadId;
+        // Поток завершился; события лежат до экспорта (exported) или clear()
+        bool retired;
+        bool exported;
+
+        explicit ThreadBuffer(unsigned id)
+            : events(kBufferCapacity), written(0), threadId(id), retired(false), exported(false) {}
+    };
+
+    /**
+     * Возвращает буфер трассировщику при завершении потока
+     */
+    struct ThreadGuard {
+        ThreadBuffer* buffer;
+
+        ThreadGuard() : buffer(nullptr) {}
+
+        ~ThreadGuard() {
+            if (buffer) {
+                instance().retire(buffer);
+            }
+        }
+    };
+
+    // Флаг и буфер потока - статические, чтобы участок не обращался к экземпляру
+    static inline std::atomic<bool> enabled_{false};
+    static inline thread_local ThreadBuffer* localBuffer_ = nullptr;
+    // Отдельно от localBuffer_: обращение к thread_local с деструктором дороже
+    static inline thread_local ThreadGuard localGuard_;
+
+    std::mutex registryMutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    // Буферы завершившихся потоков в порядке завершения
+    std::deque<ThreadBuffer*> retired_;
+    unsigned nextThreadId_;
+    std::string outputPath_;
+
+    // Точки привязки счетчика тактов к реальному времени
+    uint64_t startTicks_;
+    std::chrono::steady_clock::time_point startTime_;
+
+    Tracer() : nextThreadId_(1), startTicks_(0) {
+        if (const char* path = std::getenv("ALGORITHMS_TRACE")) {
+            if (*path) {
+                enable(path);
+            }
+        }
+    }
+
+    /**
+     * Регистрация буфера текущего потока: первый буфер завершившегося потока,
+     * чьи события уже выгружены, иначе новый
+     */
+    static ThreadBuffer* registerThread() {
+        Tracer& tracer = instance();
+        std::lock_guard<std::mutex> lock(tracer.registryMutex_);
+        ThreadBuffer* buffer = nullptr;
+        for (auto it = tracer.retired_.begin(); it != tracer.retired_.end(); ++it) {
+            if ((*it)->exported) {
+                buffer = *it;
+                tracer.retired_.erase(it);
+                break;
+            }
+        }
+        if (!buffer && tracer.retired_.size() > kMaxRetiredBuffers) {
+            buffer = tracer.retired_.front();
+            tracer.retired_.pop_front();
+        }
+
+        if (buffer) {
+            buffer->written.store(0, std::memory_order_relaxed);
+            buffer->threadId = tracer.nextThreadId_++;
+            buffer->retired = false;
+            buffer->exported = false;
+        } else {
+            tracer.buffers_.push_back(std::make_unique<ThreadBuffer>(tracer.nextThreadId_++));
+            buffer = tracer.buffers_.back().get();
+        }
+        localBuffer_ = buffer;
+        localGuard_.buffer = buffer;
+        return buffer;
+    }
+
+    void retire(ThreadBuffer* buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        buffer->retired = true;
+        retired_.push_back(buffer);
+        localBuffer_ = nullptr;
+    }
+
+    static void writeEscaped(std::ostream& out, const char* text) {
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\') {
+                out << '\\';
+            }
+            out << *text;
+        }
+    }
+
+public:
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    /**
+     * Единственный экземпляр трассировщика; при первом обращении читается ALGORITHMS_TRACE
+     */
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    /**
+     * Текущее значение часов трассировки (такты процессора, где они доступны)
+     */
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    [[nodiscard]] static bool isEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Включение трассировки
+     *
+     * @param outputPath Файл, в который flush() запишет трассу; пустая строка - без файла
+     */
+    void enable(const std::string& outputPath = "") {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        outputPath_ = outputPath;
+        if (!enabled_.load(std::memory_order_relaxed)) {
+            startTicks_ = now();
+            startTime_ = std::chrono::steady_clock::now();
+        }
+        enabled_.store(true, std::memory_order_relaxed);
+    }
+
+    static void disable() {
+        enabled_.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * Запись события в буфер текущего потока
+     */
+    static void record(const char* name, uint64_t start, uint64_t end) {
+        ThreadBuffer* buffer = localBuffer_;
+        if (!buffer) {
+            buffer = registerThread();
+        }
+        uint64_t index = buffer->written.load(std::memory_order_relaxed);
+        buffer->events[index & (kBufferCapacity - 1)] = Event{name, start, end};
+        buffer->written.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * Экспорт всех сохраненных событий в формате Chrome Trace JSON.
+     * Вызывается, когда трассируемая работа завершена: события, которые
+     * записываются одновременно с экспортом, могут быть прочитаны не целиком
+     */
+    void exportChromeTrace(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+
+        // Перевод тактов в микросекунды по двум точкам привязки
+        double elapsedMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime_).count();
+        uint64_t elapsedTicks = now() - startTicks_;
+        double microsPerTick = elapsedTicks > 0 ? elapsedMicros / static_cast<double>(elapsedTicks) : 0.0;
+
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (const auto& buffer : buffers_) {
+            buffer->exported = buffer->retired;
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t begin = written > kBufferCapacity ? written - kBufferCapacity : 0;
+            for (uint64_t i = begin; i < written; ++i) {
+                const Event& event = buffer->events[i & (kBufferCapacity - 1)];
+                double start = static_cast<double>(event.start - startTicks_) * microsPerTick;
+                double duration = static_cast<double>(event.end - event.start) * microsPerTick;
+
+                out << (first ? "\n" : ",\n") << "{\"name\":\"";
+                writeEscaped(out, event.name);
+                out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << start << ",\"dur\":" << duration << "}";
+                first = false;
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+    /**
+     * Запись трассы в файл, заданный при включении
+     *
+     * @throws std::runtime_error если файл не удалось открыть
+     */
+    void flush() {
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            path = outputPath_;
+        }
+        if (path.empty()) {
+            return;
+        }
+
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Не удалось открыть файл трассы: " + path);
+        }
+        exportChromeTrace(file);
+    }
+
+    /**
+     * Удаление всех сохраненных событий (буферы потоков сохраняются)
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        for (auto& buffer : buffers_) {
+            buffer->written.store(0, std::memory_order_relaxed);
+            buffer->exported = buffer->retired;
+        }
+    }
+
+    /**
+     * Число выделенных буферов потоков (по kBufferCapacity событий каждый)
+     */
+    [[nodiscard]] size_t bufferCount() {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        return buffers_.size();
+    }
+};
+
+/**
+ * Участок трассы: от создания объекта до конца области видимости.
+ * Имя должно жить до экспорта, обычно это строковый литерал
+ */
+class TraceSpan {
+private:
+    const char* name_;
+    uint64_t start_;
+
+public:
+    explicit TraceSpan(const char* name) : name_(nullptr), start_(0) {
+        if (Tracer::isEnabled()) {
+            name_ = name;
+            start_ = Tracer::now();
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ~TraceSpan() {
+        if (name_) {
+            Tracer::record(name_, start_, Tracer::now());
+        }
+    }
+};
+
+/**
+ * Создание трассировщика (и чтение ALGORITHMS_TRACE) при запуске программы,
+ * чтобы участки, начатые до первого обращения к instance(), тоже записывались
+ */
+inline const bool kTraceConfiguredFromEnvironment = (Tracer::instance(), true);
@@ -0,0 +1,120 @@
+// allocation_counter.h
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Подсчет выделений памяти в тестах.
+ *
+ * Заголовок заменяет глобальные operator new/delete, поэтому подключается
+ * ровно в один файл каждого тестового исполняемого файла. Счетчики
+ * у каждого потока свои: фоновые потоки не влияют на измерение.
+ *
+ * Пример бюджета выделений:
+ *   EXPECT_LE(countAllocations([&] { list.pushBack(1); }), 1u);
+ */
+class AllocationCounter {
+public:
+    static inline thread_local size_t allocations = 0;
+    static inline thread_local size_t bytes = 0;
+
+    static void* allocate(size_t size) {
+        ++allocations;
+        bytes += size;
+        if (void* pointer = std::malloc(size > 0 ? size : 1)) {
+            return pointer;
+        }
+        throw std::bad_alloc();
+    }
+
+    static void* allocateAligned(size_t size, size_t alignment) {
+        ++allocations;
+        bytes += size;
+        // aligned_alloc требует размер, кратный выравниванию
+        size_t rounded = (size + alignment - 1) / alignment * alignment;
+        if (void* pointer = std::aligned_alloc(alignment, rounded > 0 ? rounded : alignment)) {
+            return pointer;
+        }
+        throw std::bad_alloc();
+    }
+};
+
+/**
+ * Область измерения: выделения текущего потока от создания объекта
+ */
+class AllocationScope {
+private:
+    size_t startAllocations_;
+    size_t startBytes_;
+
+public:
+    AllocationScope() : startAllocations_(AllocationCounter::allocations), startBytes_(AllocationCounter::bytes) {}
+
+    [[nodiscard]] size_t allocations() const {
+        return AllocationCounter::allocations - startAllocations_;
+    }
+
+    [[nodiscard]] size_t bytes() const {
+        return AllocationCounter::bytes - startBytes_;
+    }
+};
+
+/**
+ * Количество выделений памяти, выполненных вызовом action() в текущем потоке
+ */
+template <typename Action>
+size_t countAllocations(Action&& action) {
+    AllocationScope scope;
+    action();
+    return scope.allocations();
+}
+
+void* operator new(size_t size) {
+    return AllocationCounter::allocate(size);
+}
+
+void* operator new[](size_t size) {
+    return AllocationCounter::allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return AllocationCounter::allocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return AllocationCounter::allocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+
+class BenchmarkTest : public ::testing::Test {
+protected:
+    static BenchmarkResult makeResult(const std::string& name, std::vector<double> samples) {
+        BenchmarkResult result;
+        result.name = name;
+        result.samples = std::move(samples);
+        BenchmarkStatistics::summarize(result);
+        return result;
+    }
+
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки медианы и доверительного интервала
+TEST_F(BenchmarkTest, MedianAndConfidenceInterval) {
+    auto odd = makeResult("odd", {5, 1, 4, 2, 3});
+    EXPECT_DOUBLE_EQ(3.0, odd.median);
+    EXPECT_DOUBLE_EQ(1.0, odd.low);
+    EXPECT_DOUBLE_EQ(5.0, odd.high);
+
+    auto even = makeResult("even", {4, 1, 3, 2});
+    EXPECT_DOUBLE_EQ(2.5, even.median);
+
+    // Для 100 повторений границы - 40-я и 60-я порядковые статистики
+    std::vector<double> samples;
+    for (int i = 100; i >= 1; --i) {
+        samples.push_back(i);
+    }
+    auto large = makeResult("large", samples);
+    EXPECT_DOUBLE_EQ(50.5, large.median);
+    EXPECT_DOUBLE_EQ(40.0, large.low);
+    EXPECT_DOUBLE_EQ(60.0, large.high);
+
+    BenchmarkResult empty;
+    EXPECT_THROW(BenchmarkStatistics::summarize(empty), std::invalid_argument);
+}
+
+// Тест для проверки сравнения с базовым уровнем
+TEST_F(BenchmarkTest, CompareWithBaseline) {
+    std::vector<BenchmarkResult> baseline = {
+        makeResult("stable", {10, 11, 10, 9, 10, 11, 9}),
+        makeResult("slower", {10, 11, 10, 9, 10, 11, 9}),
+        makeResult("faster", {10, 11, 10, 9, 10, 11, 9}),
+        makeResult("noisy", {10, 11, 10, 9, 10, 11, 9}),
+    };
+    std::vector<BenchmarkResult> current = {
+        makeResult("stable", {10, 10, 11, 10, 9, 10, 10}),
+        makeResult("slower", {15, 16, 15, 14, 15, 16, 15}),
+        makeResult("faster", {5, 6, 5, 4, 5, 6, 5}),
+        // Медиана выросла, но интервалы пересекаются - это шум
+        makeResult("noisy", {9, 12, 13, 14, 30, 40, 8}),
+        makeResult("added", {1, 1, 1}),
+    };
+
+    auto comparisons = BenchmarkStatistics::compare(baseline, current, 0.1);
+    ASSERT_EQ(5u, comparisons.size());
+    EXPECT_EQ(BenchmarkComparison::Status::Unchanged, comparisons[0].status);
+    EXPECT_EQ(BenchmarkComparison::Status::Regression, comparisons[1].status);
+    EXPECT_DOUBLE_EQ(1.5, comparisons[1].ratio());
+    EXPECT_EQ(BenchmarkComparison::Status::Improvement, comparisons[2].status);
+    EXPECT_EQ(BenchmarkComparison::Status::Unchanged, comparisons[3].status);
+    EXPECT_EQ(BenchmarkComparison::Status::New, comparisons[4].status);
+    EXPECT_TRUE(BenchmarkStatistics::hasRegression(comparisons));
+
+    // С порогом 60% замедление в 1.5 раза допустимо
+    EXPECT_FALSE(BenchmarkStatistics::hasRegression(BenchmarkStatistics::compare(baseline, current, 0.6)));
+}
+
+// Тест для проверки записи и чтения JSON
+TEST_F(BenchmarkTest, JsonRoundTrip) {
+    std::vector<BenchmarkResult> results = {
+        makeResult("fibonacci/generate94", {267.625, 265.1875, 274.5}),
+        makeResult("name \"with\" quotes", {0.1, 1e-9, 12345678.9}),
+    };
+
+    std::ostringstream out;
+    BenchmarkJson::write(out, results);
+    auto parsed = BenchmarkJson::parse(out.str());
+
+    ASSERT_EQ(results.size(), parsed.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].name, parsed[i].name);
+        EXPECT_EQ(results[i].samples, parsed[i].samples);
+        EXPECT_DOUBLE_EQ(results[i].median, parsed[i].median);
+        EXPECT_DOUBLE_EQ(results[i].low, parsed[i].low);
+        EXPECT_DOUBLE_EQ(results[i].high, parsed[i].high);
+    }
+}
+
+// Тест проверяет запись аппаратных счетчиков: IPC и значения на операцию, только доступные счетчики
+TEST_F(BenchmarkTest, JsonCounters) {
+    std::vector<BenchmarkResult> results = {makeResult("with counters", {1.0}), makeResult("without", {1.0})};
+    results[0].countedOperations = 1000;
+    results[0].counters.available[PerfCounters::kCycles] = true;
+    results[0].counters.values[PerfCounters::kCycles] = 2000;
+    results[0].counters.available[PerfCounters::kInstructions] = true;
+    results[0].counters.values[PerfCounters::kInstructions] = 5000;
+    results[0].counters.available[PerfCounters::kLastLevelMisses] = true;
+    results[0].counters.values[PerfCounters::kLastLevelMisses] = 250;
+
+    std::ostringstream out;
+    BenchmarkJson::write(out, results);
+    std::string text = out.str();
+    EXPECT_NE(std::string::npos, text.find("\"counters\": {\"ipc\": 2.5, \"cycles\": 2, \"instructions\": 5, \"llc_misses\": 0.25}"));
+    // У замера без счетчиков поля counters нет
+    EXPECT_EQ(text.find("\"counters\""), text.rfind("\"counters\""));
+
+    auto parsed = BenchmarkJson::parse(text);
+    ASSERT_EQ(2u, parsed.size());
+    EXPECT_EQ("without", parsed[1].name);
+    EXPECT_FALSE(parsed[0].counters.any());
+}
+
+// Тест для проверки разбора JSON с лишними полями и ошибок формата
+TEST_F(BenchmarkTest, JsonParsing) {
+    auto parsed = BenchmarkJson::parse(
+        "{\"machine\": {\"cpus\": [1, 2], \"vm\": true}, \"benchmarks\": "
+        "[{\"name\": \"a\", \"unit\": \"ns\", \"median\": 2.5, \"low\": 2, \"high\": 3, \"samples\": []}]}");
+    ASSERT_EQ(1u, parsed.size());
+    EXPECT_EQ("a", parsed[0].name);
+    EXPECT_DOUBLE_EQ(2.5, parsed[0].median);
+
+    EXPECT_TRUE(BenchmarkJson::parse("{}").empty());
+    EXPECT_THROW((void)BenchmarkJson::parse(""), std::runtime_error);
+    EXPECT_THROW((void)BenchmarkJson::parse("{\"benchmarks\": [{\"name\": \"a\"}"), std::runtime_error);
+    EXPECT_THROW((void)BenchmarkJson::parse("{\"benchmarks\": [{\"median\": x}]}"), std::runtime_error);
+    EXPECT_THROW((void)BenchmarkJson::parse("{} {}"), std::runtime_error);
+    EXPECT_THROW((void)BenchmarkJson::load("/nonexistent/baseline.json"), std::runtime_error);
+}
+
+// Тест для проверки выполнения набора замеров
+TEST_F(BenchmarkTest, SuiteRun) {
+    BenchmarkSuite suite;
+    int calls = 0;
+    suite.add("group/first", 10, [&calls] { ++calls; });
+    suite.add("group/second", 1, [] {});
+    suite.add("other", 1, [] {});
+    EXPECT_EQ(3u, suite.size());
+
+    auto results = suite.run(5, "group/");
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ("group/first", results[0].name);
+    EXPECT_EQ(5u, results[0].samples.size());
+    // Один прогревочный вызов и пять замеров
+    EXPECT_EQ(6, calls);
+    EXPECT_LE(results[0].low, results[0].median);
+    EXPECT_LE(results[0].median, results[0].high);
+    // Счетчики сняты за все повторения или недоступны целиком (например, в виртуальной машине)
+    EXPECT_EQ(50u, results[0].countedOperations);
+    if (results[0].counters.has(PerfCounters::kInstructions)) {
+        EXPECT_GT(results[0].counters.values[PerfCounters::kInstructions], 0u);
+    }
+
+    // Подготовка выполняется перед каждым вызовом, включая прогревочный
+    int prepared = 0;
+    int used = 0;
+    suite.add("prepared", 1, [&prepared, &used] { used += prepared; prepared = 0; }, [&prepared] { ++prepared; });
+    (void)suite.run(3, "prepared");
+    EXPECT_EQ(4, used);
+    EXPECT_EQ(0, prepared);
+
+    EXPECT_THROW(suite.add("empty", 0, [] {}), std::invalid_argument);
+    EXPECT_THROW((void)suite.run(0), std::invalid_argument);
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
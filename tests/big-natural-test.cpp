@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "big_natural.h"
+
+class BigNaturalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+    
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+    
+    // Псевдослучайное число из digits десятичных цифр
+    static BigNatural randomNumber(size_t digits, unsigned int seed) {
+        std::string text(digits, '0');
+        for (auto& c : text) {
+            seed = seed * 1103515245u + 12345u;
+            c = static_cast<char>('0' + (seed >> 16) % 10);
+        }
+        text[0] = '1' + seed % 9;
+        return BigNatural::fromString(text);
+    }
+};
+
+// Тест для проверки разбора и печати
+TEST_F(BigNaturalTest, StringRoundTrip) {
+    EXPECT_EQ("0", BigNatural().toString());
+    EXPECT_EQ("0", BigNatural::fromString("0000").toString());
+    EXPECT_EQ("18446744073709551615", BigNatural(18446744073709551615ULL).toString());
+    
+    std::string text = "1234567890000000001000000000987654321";
+    EXPECT_EQ(text, BigNatural::fromString(text).toString());
+    EXPECT_EQ(text.size(), BigNatural::fromString(text).digitCount());
+    
+    EXPECT_THROW(BigNatural::fromString(""), std::invalid_argument);
+    EXPECT_THROW(BigNatural::fromString("12a"), std::invalid_argument);
+}
+
+// Тест для проверки сложения и вычитания с переносами
+TEST_F(BigNaturalTest, AddSubtract) {
+    auto a = BigNatural::fromString("99999999999999999999999999");
+    auto b = BigNatural(1);
+    
+    EXPECT_EQ("100000000000000000000000000", (a + b).toString());
+    EXPECT_EQ(a, (a + b) - b);
+    EXPECT_EQ("0", (a - a).toString());
+    EXPECT_THROW(b - a, std::underflow_error);
+    EXPECT_TRUE(b < a);
+    EXPECT_FALSE(a < a);
+}
+
+// Тест для проверки умножения на малые числа
+TEST_F(BigNaturalTest, MultiplySmall) {
+    EXPECT_EQ("73786976294838206460", (BigNatural(18446744073709551615ULL) * 4u).toString());
+    EXPECT_EQ("0", (BigNatural(12345) * 0u).toString());
+    EXPECT_EQ("0", (BigNatural() * BigNatural(5)).toString());
+}
+
+// Тест для проверки согласованности всех алгоритмов умножения
+TEST_F(BigNaturalTest, MultiplicationAlgorithmsAgree) {
+    size_t sizes[][2] = {{1, 1}, {20, 300}, {300, 300}, {700, 2900}, {2500, 2500}, {9000, 8100}, {15000, 400}};
+    unsigned int seed = 1;
+    for (auto& size : sizes) {
+        auto a = randomNumber(size[0], seed++);
+        auto b = randomNumber(size[1], seed++);
+        
+        auto expected = BigNatural::multiplySchoolbook(a, b);
+        EXPECT_EQ(expected, BigNatural::multiplyKaratsuba(a, b)) << size[0] << " x " << size[1];
+        EXPECT_EQ(expected, BigNatural::multiplyNtt(a, b)) << size[0] << " x " << size[1];
+        EXPECT_EQ(expected, a * b) << size[0] << " x " << size[1];
+        EXPECT_GE(expected.digitCount(), size[0] + size[1] - 1);
+    }
+}
+
+// Тест для проверки возведения в квадрат через NTT
+TEST_F(BigNaturalTest, NttSquare) {
+    auto a = randomNumber(20000, 7);
+    
+    EXPECT_EQ(BigNatural::multiplyKaratsuba(a, a), BigNatural::multiplyNtt(a, a));
+    
+    auto nines = BigNatural::fromString(std::string(20000, '9'));
+    EXPECT_EQ(std::string(19999, '9') + "8" + std::string(19999, '0') + "1", (nines * nines).toString());
+}
+
+// Тест производительности алгоритмов умножения
+TEST_F(BigNaturalTest, MultiplicationPerformance) {
+    for (size_t digits : {1000u, 10000u, 100000u}) {
+        auto a = randomNumber(digits, 11);
+        auto b = randomNumber(digits, 12);
+        
+        auto startKaratsuba = std::chrono::high_resolution_clock::now();
+        auto karatsuba = BigNatural::multiplyKaratsuba(a, b);
+        auto endKaratsuba = std::chrono::high_resolution_clock::now();
+        auto durationKaratsuba = std::chrono::duration_cast<std::chrono::microseconds>(endKaratsuba - startKaratsuba).count();
+        
+        auto startNtt = std::chrono::high_resolution_clock::now();
+        auto ntt = BigNatural::multiplyNtt(a, b);
+        auto endNtt = std::chrono::high_resolution_clock::now();
+        auto durationNtt = std::chrono::duration_cast<std::chrono::microseconds>(endNtt - startNtt).count();
+        
+        EXPECT_EQ(karatsuba, ntt);
+        std::cout << "Умножение " << digits << "-значных чисел: Карацуба " << durationKaratsuba
+                  << " мкс, NTT " << durationNtt << " мкс\n";
+    }
+}
+
+// Тест для проверки целого квадратного корня
+TEST_F(BigNaturalTest, SquareRoot) {
+    EXPECT_EQ(BigNatural(), BigNatural::sqrt(BigNatural()));
+    EXPECT_EQ(BigNatural(3), BigNatural::sqrt(BigNatural(15)));
+    EXPECT_EQ(BigNatural(4), BigNatural::sqrt(BigNatural(16)));
+    EXPECT_EQ(BigNatural(99999999), BigNatural::sqrt(BigNatural(9999999999999999ULL)));
+    
+    unsigned int seed = 100;
+    for (size_t digits : {5u, 9u, 16u, 17u, 80u, 1001u, 4000u}) {
+        auto root = randomNumber(digits, seed++);
+        auto square = root * root;
+        
+        EXPECT_EQ(root, BigNatural::sqrt(square)) << digits;
+        // (r + 1)^2 - 1 = r^2 + 2r еще имеет корень r
+        EXPECT_EQ(root, BigNatural::sqrt(square + root * 2u)) << digits;
+        EXPECT_TRUE(BigNatural::isPerfectSquare(square)) << digits;
+        EXPECT_FALSE(BigNatural::isPerfectSquare(square + BigNatural(1))) << digits;
+    }
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "compact_list.h"
+#include "allocation_counter.h"
+
+class CompactListTest : public ::testing::Test {
+protected:
+    static std::vector<int> makeValues(int size) {
+        std::vector<int> values(size);
+        for (int i = 0; i < size; ++i) {
+            values[i] = i;
+        }
+        return values;
+    }
+
+    // Байтов на элемент в списках из count элементов, построенных pushFront, пакетно и в CompactList
+    template <typename T, typename Make>
+    static void printFootprint(const char* name, size_t count, Make make) {
+        std::vector<T> values;
+        for (size_t i = 0; i < count; ++i) {
+            values.push_back(make(i));
+        }
+
+        LinkedList<T> pushed;
+        for (size_t i = count; i-- > 0;) {
+            pushed.pushFront(values[i]);
+        }
+        LinkedList<T> bulk(values);
+        CompactList<T> compact(values);
+
+        double perPushed = static_cast<double>(pushed.memoryUsage().total()) / count;
+        double perBulk = static_cast<double>(bulk.memoryUsage().total()) / count;
+        double perCompact = static_cast<double>(compact.memoryUsage().total()) / count;
+        std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << perPushed << std::setw(12) << perBulk << std::setw(12) << perCompact << "\n";
+
+        EXPECT_LT(perCompact, perBulk);
+        EXPECT_LT(perCompact, perPushed);
+    }
+
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки основных операций
+TEST_F(CompactListTest, BasicOperations) {
+    CompactList<int> list;
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_THROW(list.popFront(), std::out_of_range);
+    EXPECT_THROW((void)list.front(), std::out_of_range);
+
+    list.pushBack(2);
+    list.pushFront(1);
+    list.pushBack(3);
+    EXPECT_EQ(3u, list.size());
+    EXPECT_EQ(1, list.front());
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), list.toVector());
+
+    list.reverse();
+    list.pushBack(0);
+    EXPECT_EQ(std::vector<int>({3, 2, 1, 0}), list.toVector());
+
+    list.popFront();
+    list.popFront();
+    EXPECT_EQ(std::vector<int>({1, 0}), list.toVector());
+
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    list.pushBack(7);
+    EXPECT_EQ(std::vector<int>({7}), list.toVector());
+
+    EXPECT_EQ(makeValues(100), CompactList<int>(makeValues(100)).toVector());
+}
+
+// Тест для проверки повторного использования освобожденных узлов и упаковки
+TEST_F(CompactListTest, FreeListAndShrink) {
+    CompactList<std::string> list;
+    for (int i = 0; i < 100; ++i) {
+        list.pushBack(std::string(50, static_cast<char>('a' + i % 26)));
+    }
+    size_t nodes = list.memoryUsage().nodes;
+
+    // Освобожденные узлы переиспользуются без выделения памяти под узлы,
+    // а их строки сразу отдают свои буферы
+    size_t payload = list.memoryUsage().payload;
+    for (int i = 0; i < 50; ++i) {
+        list.popFront();
+    }
+    EXPECT_EQ(payload / 2, list.memoryUsage().payload);
+    for (int i = 0; i < 50; ++i) {
+        list.pushFront("short");
+    }
+    EXPECT_EQ(nodes, list.memoryUsage().nodes);
+    EXPECT_EQ(100u, list.size());
+
+    for (int i = 0; i < 60; ++i) {
+        list.popFront();
+    }
+    auto expected = list.toVector();
+    list.shrinkToFit();
+    EXPECT_EQ(expected, list.toVector());
+    EXPECT_EQ(40 * CompactList<std::string>::nodeSize(), list.memoryUsage().nodes);
+    list.pushBack("tail");
+    list.pushFront("head");
+    EXPECT_EQ("head", list.front());
+    EXPECT_EQ(42u, list.toVector().size());
+}
+
+// Тест для проверки учета памяти: узлы без отдельных выделений
+TEST_F(CompactListTest, MemoryUsage) {
+    EXPECT_EQ(8u, CompactList<int>::nodeSize());
+    EXPECT_EQ(16u, CompactList<long long>::nodeSize());
+
+    CompactList<int> list;
+    AllocationScope scope;
+    list.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        list.pushFront(i);
+    }
+    EXPECT_EQ(1u, scope.allocations());
+    EXPECT_EQ(scope.bytes(), list.memoryUsage().nodes);
+    EXPECT_EQ(sizeof(list) + 1000 * CompactList<int>::nodeSize(), list.memoryUsage().total());
+}
+
+// Сравнение памяти на элемент: узлы LinkedList и компактные узлы
+TEST_F(CompactListTest, MemoryFootprint) {
+    const size_t SIZE = 100000;
+    std::cout << "Байтов на элемент для " << SIZE << " элементов (без заголовков malloc)\n";
+    std::cout << "тип           pushFront    пакетно    CompactList\n";
+    printFootprint<int>("int", SIZE, [](size_t i) { return static_cast<int>(i); });
+    printFootprint<long long>("long long", SIZE, [](size_t i) { return static_cast<long long>(i); });
+    printFootprint<std::string>("string", SIZE, [](size_t i) { return "item" + std::to_string(i); });
+    printFootprint<std::string>("string(40)", SIZE, [](size_t i) { return std::string(40, static_cast<char>('a' + i % 26)); });
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
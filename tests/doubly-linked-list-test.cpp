@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "doubly_linked_list.h"
+#include "linked_list.h"
+#include "allocation_counter.h"
+
+class DoublyLinkedListTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+    
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки пустого списка
+TEST_F(DoublyLinkedListTest, EmptyList) {
+    DoublyLinkedList<int> list;
+    
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(0, list.size());
+    EXPECT_TRUE(list.begin() == list.end());
+    EXPECT_THROW(list.popFront(), std::out_of_range);
+    EXPECT_THROW(list.popBack(), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(list.front()), std::out_of_range);
+    
+    list.reverse();
+    EXPECT_TRUE(list.toVector().empty());
+}
+
+// Тест для проверки добавления в начало и в конец
+TEST_F(DoublyLinkedListTest, PushFrontAndBack) {
+    DoublyLinkedList<int> list;
+    list.pushBack(2);
+    list.pushBack(3);
+    list.pushFront(1);
+    
+    EXPECT_EQ(3, list.size());
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), list.toVector());
+    EXPECT_EQ(1, list.front());
+    EXPECT_EQ(3, list.back());
+}
+
+// Тест для проверки разворота
+TEST_F(DoublyLinkedListTest, Reverse) {
+    DoublyLinkedList<int> list(std::vector<int>{1, 2, 3, 4, 5});
+    
+    list.reverse();
+    
+    EXPECT_EQ(std::vector<int>({5, 4, 3, 2, 1}), list.toVector());
+    EXPECT_EQ(5, list.front());
+    EXPECT_EQ(1, list.back());
+    EXPECT_EQ(5, list.size());
+}
+
+// Тест для проверки двойного разворота
+TEST_F(DoublyLinkedListTest, ReverseTwice) {
+    DoublyLinkedList<int> list(std::vector<int>{1, 2, 3});
+    
+    list.reverse();
+    list.reverse();
+    
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), list.toVector());
+}
+
+// Тест для проверки того, что операции после разворота учитывают направление
+TEST_F(DoublyLinkedListTest, OperationsHonourDirection) {
+    DoublyLinkedList<std::string> list(std::vector<std::string>{"b", "c"});
+    
+    list.reverse();
+    list.pushFront("d");
+    list.pushBack("a");
+    
+    EXPECT_EQ(std::vector<std::string>({"d", "c", "b", "a"}), list.toVector());
+    EXPECT_EQ("a", list.popBack());
+    EXPECT_EQ("d", list.popFront());
+    
+    list.reverse();
+    EXPECT_EQ(std::vector<std::string>({"b", "c"}), list.toVector());
+    list.pushBack("e");
+    EXPECT_EQ(std::vector<std::string>({"b", "c", "e"}), list.toVector());
+}
+
+// Тест для проверки удаления с обоих концов до опустошения
+TEST_F(DoublyLinkedListTest, PopUntilEmpty) {
+    DoublyLinkedList<int> list(std::vector<int>{1, 2, 3});
+    
+    EXPECT_EQ(3, list.popBack());
+    list.reverse();
+    EXPECT_EQ(2, list.popFront());
+    EXPECT_EQ(1, list.popBack());
+    EXPECT_TRUE(list.isEmpty());
+    
+    list.pushBack(7);
+    EXPECT_EQ(7, list.front());
+    EXPECT_EQ(7, list.back());
+}
+
+// Тест для проверки копирования с учетом направления
+TEST_F(DoublyLinkedListTest, CopyPreservesLogicalOrder) {
+    DoublyLinkedList<int> list(std::vector<int>{1, 2, 3});
+    list.reverse();
+    
+    DoublyLinkedList<int> copy(list);
+    copy.pushBack(0);
+    
+    EXPECT_EQ(std::vector<int>({3, 2, 1}), list.toVector());
+    EXPECT_EQ(std::vector<int>({3, 2, 1, 0}), copy.toVector());
+    
+    DoublyLinkedList<int> moved(std::move(copy));
+    EXPECT_EQ(4, moved.size());
+    EXPECT_TRUE(copy.isEmpty());
+}
+
+// Тест производительности многократного разворота в сравнении с LinkedList
+TEST_F(DoublyLinkedListTest, Performance) {
+    const int SIZE = 100000;
+    const int REVERSALS = 1000;
+    
+    DoublyLinkedList<int> doublyList;
+    LinkedList<int> singlyList;
+    for (int i = 0; i < SIZE; ++i) {
+        doublyList.pushBack(i);
+        singlyList.pushFront(SIZE - 1 - i);
+    }
+    
+    auto startDoubly = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < REVERSALS; ++i) {
+        doublyList.reverse();
+    }
+    auto endDoubly = std::chrono::high_resolution_clock::now();
+    auto durationDoubly = std::chrono::duration_cast<std::chrono::microseconds>(endDoubly - startDoubly).count();
+    
+    auto startSingly = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < REVERSALS; ++i) {
+        singlyList.reverse();
+    }
+    auto endSingly = std::chrono::high_resolution_clock::now();
+    auto durationSingly = std::chrono::duration_cast<std::chrono::microseconds>(endSingly - startSingly).count();
+    
+    EXPECT_EQ(singlyList.toVector(), doublyList.toVector());
+    
+    std::cout << REVERSALS << " разворотов двусвязного списка из " << SIZE << " элементов: "
+              << durationDoubly << " мкс\n";
+    std::cout << REVERSALS << " разворотов LinkedList из " << SIZE << " элементов: "
+              << durationSingly << " мкс\n";
+}
+
+// Тест для проверки бюджета выделений памяти: один узел на добавление,
+// удаление, разворот и обход память не выделяют
+TEST_F(DoublyLinkedListTest, AllocationBudget) {
+    DoublyLinkedList<int> list;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_LE(countAllocations([&] { list.pushBack(i); }), 1u);
+        EXPECT_LE(countAllocations([&] { list.pushFront(-i); }), 1u);
+    }
+
+    long long sum = 0;
+    EXPECT_EQ(0u, countAllocations([&] {
+        list.reverse();
+        for (int value : list) {
+            sum += value;
+        }
+        sum += list.popFront();
+        sum += list.popBack();
+    }));
+    EXPECT_EQ(0, sum);
+    EXPECT_EQ(198u, list.size());
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "fibonacci.h"
+#include "fibonacci_cache.h"
+#include "allocation_counter.h"
+
+class FibonacciCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки совпадения префикса с генерацией
+TEST_F(FibonacciCacheTest, PrefixMatchesGenerated) {
+    FibonacciCache<unsigned long long> cache;
+
+    for (size_t n : {1u, 2u, 10u, 64u, 65u, 94u}) {
+        auto view = cache.prefix(n);
+        EXPECT_EQ(n, view.size());
+        EXPECT_EQ(FibonacciGenerator::generateFibonacci(n), view.toVector()) << "n = " << n;
+    }
+    EXPECT_EQ(94u, cache.size());
+}
+
+// Тест для проверки ошибок
+TEST_F(FibonacciCacheTest, Errors) {
+    FibonacciCache<unsigned long long> cache;
+
+    EXPECT_THROW(cache.prefix(0), std::invalid_argument);
+    EXPECT_THROW(cache.prefix(95), std::overflow_error);
+    EXPECT_THROW((void)cache.prefix(10).at(10), std::out_of_range);
+
+    // После неудачного достраивания кэш остается работоспособным
+    EXPECT_EQ(12200160415121876738ULL, cache[93]);
+}
+
+// Тест проверяет, что достраивание не перемещает и не пересчитывает числа
+TEST_F(FibonacciCacheTest, ExtensionKeepsElementsInPlace) {
+    FibonacciCache<BigNatural> cache;
+
+    auto small = cache.prefix(100);
+    const BigNatural* address = &small[99];
+    auto large = cache.prefix(5000);
+
+    EXPECT_EQ(address, &large[99]);
+    EXPECT_EQ(FibonacciGenerator::fibonacciBig(99), small[99]);
+    EXPECT_EQ(FibonacciGenerator::fibonacciBig(4999), large[4999]);
+}
+
+// Тест для проверки общего кэша при одновременных запросах
+TEST_F(FibonacciCacheTest, ConcurrentReaders) {
+    auto& cache = FibonacciCache<BigNatural>::instance();
+    const int threadCount = 8;
+    std::vector<int> mismatches(threadCount, 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&cache, &mismatches, t] {
+            for (size_t n = 1 + t; n < 3000; n += 97 + t) {
+                auto view = cache.prefix(n);
+                for (size_t i = 2; i < n; i += 31) {
+                    if (view[i] != view[i - 1] + view[i - 2]) {
+                        ++mismatches[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < threadCount; ++t) {
+        EXPECT_EQ(0, mismatches[t]) << "поток " << t;
+    }
+    EXPECT_EQ(&FibonacciCache<BigNatural>::instance(), &cache);
+}
+
+// Тест производительности повторных запросов в сравнении с генерацией
+TEST_F(FibonacciCacheTest, Performance) {
+    auto& cache = FibonacciCache<unsigned long long>::instance();
+    const int requests = 1000000;
+    unsigned long long checksum = 0;
+
+    auto startGenerate = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < requests; ++i) {
+        checksum += FibonacciGenerator::generateFibonacci(1 + i % 94).back();
+    }
+    auto endGenerate = std::chrono::high_resolution_clock::now();
+
+    auto startCache = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < requests; ++i) {
+        auto view = cache.prefix(1 + i % 94);
+        checksum -= view[view.size() - 1];
+    }
+    auto endCache = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(0u, checksum);
+
+    auto durationGenerate = std::chrono::duration_cast<std::chrono::milliseconds>(endGenerate - startGenerate).count();
+    auto durationCache = std::chrono::duration_cast<std::chrono::milliseconds>(endCache - startCache).count();
+    std::cout << requests << " запросов префикса: генерация " << durationGenerate << " мс, кэш "
+              << durationCache << " мс" << std::endl;
+}
+
+// Тест для проверки бюджета выделений памяти: чтение вычисленного префикса
+// память не выделяет, достраивание выделяет только новые сегменты
+TEST_F(FibonacciCacheTest, AllocationBudget) {
+    FibonacciCache<unsigned long long> cache;
+    EXPECT_LE(countAllocations([&] { (void)cache.prefix(10); }), 1u);
+    EXPECT_EQ(0u, countAllocations([&] { (void)cache.prefix(60); }));
+    EXPECT_LE(countAllocations([&] { (void)cache.prefix(94); }), 1u);
+
+    unsigned long long sum = 0;
+    EXPECT_EQ(0u, countAllocations([&] {
+        auto view = cache.prefix(94);
+        for (size_t i = 0; i < view.size(); ++i) {
+            sum += view[i] & 1;
+        }
+        sum += cache[50] & 1;
+    }));
+    EXPECT_GT(sum, 0u);
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
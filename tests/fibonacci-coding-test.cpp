@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "fibonacci_coding.h"
+#include "allocation_counter.h"
+
+class FibonacciCodingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+    
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+    
+    static std::vector<uint64_t> roundTrip(const std::vector<uint64_t>& values) {
+        auto stream = FibonacciCoder::encode(values.data(), values.size());
+        return FibonacciCoder::decode(stream);
+    }
+};
+
+// Тест для проверки кодов малых чисел
+TEST_F(FibonacciCodingTest, SmallCodes) {
+    uint64_t values[] = {1, 2, 3, 4};
+    auto stream = FibonacciCoder::encode(values, 4);
+    
+    // 1 -> 11, 2 -> 011, 3 -> 0011, 4 -> 1011 (биты от младшего к старшему)
+    ASSERT_EQ(2 + 3 + 4 + 4, stream.bitCount);
+    ASSERT_EQ(1, stream.words.size());
+    EXPECT_EQ(0b1101'1100'110'11ULL, stream.words[0]);
+}
+
+// Тест для проверки кодирования и декодирования последовательного диапазона
+TEST_F(FibonacciCodingTest, RoundTripRange) {
+    std::vector<uint64_t> values;
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        values.push_back(value);
+    }
+    
+    EXPECT_EQ(values, roundTrip(values));
+}
+
+// Тест для проверки длинных кодов, пересекающих границы слов
+TEST_F(FibonacciCodingTest, RoundTripLargeValues) {
+    const auto fibonacci = FibonacciGenerator::generateFibonacci(94);
+    std::vector<uint64_t> values = {
+        1, UINT64_MAX, 2, fibonacci[93], fibonacci[93] - 1, 1ULL << 63, fibonacci[66], fibonacci[65] + 1,
+        fibonacci[64] + fibonacci[62], 3, UINT64_MAX - 1, 12345678901234567ULL
+    };
+    
+    EXPECT_EQ(values, roundTrip(values));
+    
+    uint64_t maxValue = UINT64_MAX;
+    auto stream = FibonacciCoder::encode(&maxValue, 1);
+    EXPECT_EQ(FibonacciCoder::kMaxCodeLength, stream.bitCount);
+}
+
+// Тест для проверки чисел с кодами всех возможных длин при всех сдвигах в слове
+TEST_F(FibonacciCodingTest, RoundTripAllLengthsAndOffsets) {
+    const auto fibonacci = FibonacciGenerator::generateFibonacci(94);
+    std::vector<uint64_t> values;
+    for (size_t shift = 0; shift < 64; ++shift) {
+        values.push_back(1);
+        for (size_t k = 2; k < fibonacci.size(); k += 1 + shift % 3) {
+            values.push_back(fibonacci[k]);
+            values.push_back(fibonacci[k] + (k > 3 ? fibonacci[k - 2] : 0));
+        }
+    }
+    
+    EXPECT_EQ(values, roundTrip(values));
+}
+
+// Тест для проверки ошибок
+TEST_F(FibonacciCodingTest, InvalidInput) {
+    uint64_t zero = 0;
+    EXPECT_THROW(FibonacciCoder::encode(&zero, 1), std::invalid_argument);
+    
+    FibonacciBitStream truncated;
+    truncated.words = {0b0101};
+    truncated.bitCount = 4;
+    EXPECT_THROW(FibonacciCoder::decode(truncated), std::runtime_error);
+    
+    FibonacciBitStream empty;
+    EXPECT_TRUE(FibonacciCoder::decode(empty).empty());
+}
+
+// Тест производительности декодирования малых чисел
+TEST_F(FibonacciCodingTest, Performance) {
+    const size_t SIZE = 10000000;
+    std::vector<uint64_t> values(SIZE);
+    uint64_t state = 88172645463325252ULL;
+    for (auto& value : values) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        // Преобладают малые числа, как в логах
+        value = 1 + (state & 0xFF) * ((state >> 8) & 3 ? 1 : 0x1000);
+    }
+    
+    auto startEncode = std::chrono::high_resolution_clock::now();
+    auto stream = FibonacciCoder::encode(values.data(), values.size());
+    auto endEncode = std::chrono::high_resolution_clock::now();
+    double encodeSeconds = std::chrono::duration<double>(endEncode - startEncode).count();
+    
+    std::vector<uint64_t> decoded(SIZE);
+    auto startDecode = std::chrono::high_resolution_clock::now();
+    size_t count = FibonacciCoder::decode(stream, decoded.data(), decoded.size());
+    auto endDecode = std::chrono::high_resolution_clock::now();
+    double decodeSeconds = std::chrono::duration<double>(endDecode - startDecode).count();
+    
+    EXPECT_EQ(SIZE, count);
+    EXPECT_EQ(values, decoded);
+    
+    double rawBytes = static_cast<double>(SIZE * sizeof(uint64_t));
+    std::cout << "Средняя длина кода: " << static_cast<double>(stream.bitCount) / SIZE << " бит\n";
+    std::cout << "Кодирование: " << rawBytes / encodeSeconds / 1e9 << " ГБ/с\n";
+    std::cout << "Декодирование: " << rawBytes / decodeSeconds / 1e9 << " ГБ/с\n";
+}
+
+// Тест для проверки бюджета выделений памяти: декодирование пишет в готовый массив
+// и память не выделяет
+TEST_F(FibonacciCodingTest, AllocationBudget) {
+    std::vector<uint64_t> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = i * i * 7919 + 1;
+    }
+    FibonacciBitStream stream = FibonacciCoder::encode(values.data(), values.size());
+    std::vector<uint64_t> decoded(values.size());
+
+    size_t count = 0;
+    EXPECT_EQ(0u, countAllocations([&] {
+        count = FibonacciCoder::decode(stream, decoded.data(), decoded.size());
+    }));
+    EXPECT_EQ(values.size(), count);
+    EXPECT_EQ(values, decoded);
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
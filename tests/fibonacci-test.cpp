@@ -2,7 +2,11 @@
 #include <vector>
 #include <stdexcept>
 #include <limits>
+#include <string>
+#include <cstdint>
+#include <algorithm>
 #include "fibonacci.h"
+#include "allocation_counter.h"
 
 class FibonacciTest : public ::testing::Test {
 protected:
@@ -58,25 +62,27 @@ TEST_F(FibonacciTest, MediumSequence) {
     EXPECT_EQ(0, result[0]);
     EXPECT_EQ(1, result[1]);
     EXPECT_EQ(55, result[10]);
-    EXPECT_EQ(6765, result[19]);
+    EXPECT_EQ(4181, result[19]);
 }
 
 // Тест для больших чисел (но не вызывающих переполнение)
 TEST_F(FibonacciTest, LargeValidNumbers) {
-    // 92 - максимальный индекс, который помещается в unsigned long long
-    auto result = FibonacciGenerator::generateFibonacci(92);
+    // F(93) - наибольшее число Фибоначчи, которое помещается в unsigned long long,
+    // поэтому 94 - наибольшее допустимое количество чисел
+    auto result = FibonacciGenerator::generateFibonacci(94);
     
-    ASSERT_EQ(92, result.size());
+    ASSERT_EQ(94, result.size());
     
-    // Проверяем последний элемент, который должен быть максимальным числом, 
+    // Проверяем последние элементы, последний - максимальное число Фибоначчи,
     // которое помещается в unsigned long long
-    EXPECT_EQ(7540113804746346429ULL, result[91]);
+    EXPECT_EQ(7540113804746346429ULL, result[92]);
+    EXPECT_EQ(12200160415121876738ULL, result[93]);
 }
 
 // Тест проверяет обработку переполнения
 TEST_F(FibonacciTest, OverflowHandling) {
-    // 93-е число Фибоначчи вызывает переполнение для unsigned long long
-    EXPECT_THROW(FibonacciGenerator::generateFibonacci(93), std::overflow_error);
+    // F(94) - 95-е число последовательности - вызывает переполнение для unsigned long long
+    EXPECT_THROW(FibonacciGenerator::generateFibonacci(95), std::overflow_error);
 }
 
 // Тест производительности для больших значений n
@@ -93,7 +99,240 @@ TEST_F(FibonacciTest, Performance) {
     EXPECT_LT(duration, 10);
     
     // Проверяем правильность конечного результата
-    EXPECT_EQ(12586269025ULL, result[49]);
+    EXPECT_EQ(7778742049ULL, result[49]);
+}
+
+// Тест проверяет, что fibonacciBig совпадает с итеративной генерацией
+TEST_F(FibonacciTest, BigMatchesGenerated) {
+    auto expected = FibonacciGenerator::generateFibonacci(93);
+    
+    for (unsigned long long n = 0; n < expected.size(); ++n) {
+        EXPECT_EQ(std::to_string(expected[n]), FibonacciGenerator::fibonacciBig(n).toString()) << "n = " << n;
+    }
+}
+
+// Тест проверяет известные значения за пределами unsigned long long
+TEST_F(FibonacciTest, BigKnownValues) {
+    EXPECT_EQ("354224848179261915075", FibonacciGenerator::fibonacciBig(100).toString());
+    EXPECT_EQ("280571172992510140037611932413038677189525",
+              FibonacciGenerator::fibonacciBig(200).toString());
+    EXPECT_EQ(209u, FibonacciGenerator::fibonacciBig(1000).digitCount());
+}
+
+// Тест проверяет тождество F(2n) = F(n) * (F(n + 1) + F(n - 1)) на размерах,
+// где умножение идет через NTT
+TEST_F(FibonacciTest, BigDoublingIdentity) {
+    for (unsigned long long n : {5000ULL, 77777ULL, 400001ULL}) {
+        auto previous = FibonacciGenerator::fibonacciBig(n - 1);
+        auto current = FibonacciGenerator::fibonacciBig(n);
+        auto next = FibonacciGenerator::fibonacciBig(n + 1);
+        
+        EXPECT_EQ(FibonacciGenerator::fibonacciBig(2 * n), current * (next + previous)) << "n = " << n;
+        EXPECT_EQ(next, current + previous) << "n = " << n;
+    }
+}
+
+// Тест производительности вычисления огромных чисел Фибоначчи
+TEST_F(FibonacciTest, BigPerformance) {
+    for (unsigned long long n : {1000ULL, 100000ULL, 1000000ULL, 10000000ULL}) {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto value = FibonacciGenerator::fibonacciBig(n);
+        auto computed = std::chrono::high_resolution_clock::now();
+        std::string text = value.toString();
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        auto computeTime = std::chrono::duration_cast<std::chrono::milliseconds>(computed - start).count();
+        auto printTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - computed).count();
+        std::cout << "F(" << n << "): " << text.size() << " цифр, вычисление: " << computeTime
+                  << " мс, перевод в строку: " << printTime << " мс" << std::endl;
+        
+        // Число цифр F(n) равно floor(n * log10(phi) - log10(sqrt(5))) + 1
+        EXPECT_NEAR(static_cast<double>(text.size()), n * 0.20898764024997873, 2.0);
+    }
+}
+
+// Тест проверяет распознавание чисел Фибоначчи и их соседей
+TEST_F(FibonacciTest, IsFibonacci) {
+    auto fibonacci = FibonacciGenerator::generateFibonacci(94);
+    
+    for (unsigned long long value : fibonacci) {
+        EXPECT_TRUE(FibonacciGenerator::isFibonacci(value)) << value;
+        if (value > 3) {
+            EXPECT_FALSE(FibonacciGenerator::isFibonacci(value - 1)) << value - 1;
+            EXPECT_FALSE(FibonacciGenerator::isFibonacci(value + 1)) << value + 1;
+        }
+    }
+    
+    EXPECT_FALSE(FibonacciGenerator::isFibonacci(4));
+    EXPECT_FALSE(FibonacciGenerator::isFibonacci(std::numeric_limits<uint64_t>::max()));
+}
+
+// Тест проверяет пакетную проверку на подряд идущих числах
+TEST_F(FibonacciTest, IsFibonacciBatch) {
+    std::vector<uint64_t> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = i;
+    }
+    std::vector<uint8_t> result(values.size());
+    
+    FibonacciGenerator::isFibonacciBatch(values.data(), values.size(), result.data());
+    
+    std::vector<uint64_t> found;
+    for (size_t i = 0; i < result.size(); ++i) {
+        if (result[i]) {
+            found.push_back(values[i]);
+        }
+    }
+    std::vector<uint64_t> expected = {0, 1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144, 233, 377, 610, 987};
+    EXPECT_EQ(expected, found);
+}
+
+// Тест проверяет, что пакетная проверка совпадает с поштучной на соседях чисел Фибоначчи и на хвосте массива
+TEST_F(FibonacciTest, IsFibonacciBatchMatchesScalar) {
+    std::vector<uint64_t> values;
+    for (uint64_t number : FibonacciGenerator::generateFibonacci(94)) {
+        values.insert(values.end(), {number - 1, number, number + 1, number ^ (uint64_t(1) << 63)});
+    }
+    values.push_back(std::numeric_limits<uint64_t>::max());
+    
+    for (size_t count : {values.size(), values.size() - 3, size_t(7), size_t(0)}) {
+        std::vector<uint8_t> result(count, 2);
+        FibonacciGenerator::isFibonacciBatch(values.data(), count, result.data());
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(FibonacciGenerator::isFibonacci(values[i]), result[i] == 1) << "value = " << values[i];
+        }
+    }
+}
+
+// Тест проверяет признак 5n^2 +- 4 для чисел произвольной длины
+TEST_F(FibonacciTest, IsFibonacciBig) {
+    EXPECT_TRUE(FibonacciGenerator::isFibonacci(BigNatural()));
+    EXPECT_TRUE(FibonacciGenerator::isFibonacci(BigNatural(1)));
+    EXPECT_FALSE(FibonacciGenerator::isFibonacci(BigNatural(4)));
+    
+    for (unsigned long long n : {100ULL, 1001ULL, 20000ULL}) {
+        auto value = FibonacciGenerator::fibonacciBig(n);
+        EXPECT_TRUE(FibonacciGenerator::isFibonacci(value)) << "n = " << n;
+        EXPECT_FALSE(FibonacciGenerator::isFibonacci(value + BigNatural(1))) << "n = " << n;
+        EXPECT_FALSE(FibonacciGenerator::isFibonacci(value * 2u)) << "n = " << n;
+    }
+}
+
+// Тест производительности пакетной проверки
+TEST_F(FibonacciTest, IsFibonacciBatchPerformance) {
+    const size_t count = 1 << 24;
+    auto fibonacci = FibonacciGenerator::generateFibonacci(94);
+    std::vector<uint64_t> values(count);
+    uint64_t seed = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        // Каждое восьмое число - число Фибоначчи
+        values[i] = (i % 8 == 0) ? fibonacci[seed % fibonacci.size()] : seed >> (seed % 64);
+    }
+    std::vector<uint8_t> result(count);
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    FibonacciGenerator::isFibonacciBatch(values.data(), count, result.data());
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    
+    for (size_t i = 0; i < count; i += 8) {
+        EXPECT_EQ(1, result[i]);
+    }
+    std::cout << "Пакетная проверка " << count << " чисел: " << seconds * 1000 << " мс, "
+              << count * sizeof(uint64_t) / seconds / 1e9 << " ГБ/с" << std::endl;
+}
+
+// Тест проверяет генерацию в других типах с проверкой переполнения
+TEST_F(FibonacciTest, TypedCheckedGeneration) {
+    auto compact = FibonacciGenerator::generateFibonacci<uint32_t>(48);
+    EXPECT_EQ(2971215073u, compact.back());
+    EXPECT_THROW(FibonacciGenerator::generateFibonacci<uint32_t>(49), std::overflow_error);
+    
+    auto wide = FibonacciGenerator::generateFibonacci<unsigned __int128>(187);
+    EXPECT_EQ(FibonacciGenerator::fibonacciBig(186),
+              BigNatural(static_cast<uint64_t>(wide.back() >> 64)) * BigNatural(1ULL << 32) * BigNatural(1ULL << 32) +
+              BigNatural(static_cast<uint64_t>(wide.back())));
+    EXPECT_THROW(FibonacciGenerator::generateFibonacci<unsigned __int128>(188), std::overflow_error);
+}
+
+// Тест проверяет насыщение при переполнении
+TEST_F(FibonacciTest, SaturatingGeneration) {
+    auto fibonacci = FibonacciGenerator::generateFibonacci<uint64_t, SaturatingArithmetic>(100);
+    
+    EXPECT_EQ(12200160415121876738ULL, fibonacci[93]);
+    for (size_t i = 94; i < fibonacci.size(); ++i) {
+        EXPECT_EQ(std::numeric_limits<uint64_t>::max(), fibonacci[i]) << "i = " << i;
+    }
+}
+
+// Тест проверяет генерацию по модулю 2^разрядность
+TEST_F(FibonacciTest, WrappingGeneration) {
+    for (unsigned int n : {1u, 2u, 15u, 16u, 17u, 1000u}) {
+        auto wide = FibonacciGenerator::generateFibonacci<uint64_t, WrappingArithmetic>(n);
+        auto narrow = FibonacciGenerator::generateFibonacci<uint32_t, WrappingArithmetic>(n);
+        ASSERT_EQ(n, wide.size());
+        ASSERT_EQ(n, narrow.size());
+        
+        uint64_t previous = 0;
+        uint64_t current = 1;
+        for (unsigned int i = 0; i < n; ++i) {
+            EXPECT_EQ(previous, wide[i]) << "i = " << i;
+            EXPECT_EQ(static_cast<uint32_t>(previous), narrow[i]) << "i = " << i;
+            uint64_t next = previous + current;
+            previous = current;
+            current = next;
+        }
+    }
+    
+    EXPECT_THROW((FibonacciGenerator::generateFibonacci<uint64_t, WrappingArithmetic>(0)), std::invalid_argument);
+}
+
+// Тест производительности генерации по модулю 2^64 в сравнении с последовательным циклом
+TEST_F(FibonacciTest, WrappingGenerationPerformance) {
+    const unsigned int count = 20000000;
+    
+    auto startSequential = std::chrono::high_resolution_clock::now();
+    std::vector<uint64_t> sequential(count);
+    sequential[1] = 1;
+    for (unsigned int i = 2; i < count; ++i) {
+        sequential[i] = sequential[i - 1] + sequential[i - 2];
+    }
+    auto endSequential = std::chrono::high_resolution_clock::now();
+    
+    auto startWrapping = std::chrono::high_resolution_clock::now();
+    auto wrapping = FibonacciGenerator::generateFibonacci<uint64_t, WrappingArithmetic>(count);
+    auto endWrapping = std::chrono::high_resolution_clock::now();
+    
+    EXPECT_EQ(sequential, wrapping);
+    
+    auto durationSequential = std::chrono::duration_cast<std::chrono::milliseconds>(endSequential - startSequential).count();
+    auto durationWrapping = std::chrono::duration_cast<std::chrono::milliseconds>(endWrapping - startWrapping).count();
+    std::cout << "Генерация " << count << " чисел по модулю 2^64: последовательно " << durationSequential
+              << " мс, без зависимости между соседями " << durationWrapping << " мс" << std::endl;
+}
+
+// Тест для проверки бюджета выделений памяти: генерация выделяет только
+// вектор результата, проверка принадлежности последовательности память не выделяет
+TEST_F(FibonacciTest, AllocationBudget) {
+    std::vector<uint64_t> sequence;
+    EXPECT_LE(countAllocations([&] { sequence = FibonacciGenerator::generateFibonacci<uint64_t>(94); }), 1u);
+
+    std::vector<uint64_t> wrapped;
+    EXPECT_LE(countAllocations([&] {
+        wrapped = FibonacciGenerator::generateFibonacci<uint64_t, WrappingArithmetic>(1000);
+    }), 1u);
+
+    std::vector<uint8_t> flags(sequence.size());
+    size_t found = 0;
+    EXPECT_EQ(0u, countAllocations([&] {
+        for (uint64_t value : sequence) {
+            found += FibonacciGenerator::isFibonacci(value);
+        }
+        FibonacciGenerator::isFibonacciBatch(sequence.data(), sequence.size(), flags.data());
+    }));
+    EXPECT_EQ(sequence.size(), found);
+    EXPECT_EQ(sequence.size(), static_cast<size_t>(std::count(flags.begin(), flags.end(), 1)));
 }
 
 // Функция main является необязательной, если вы используете gtest_main
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "linear_recurrence.h"
+#include "allocation_counter.h"
+
+class LinearRecurrenceTest : public ::testing::Test {
+protected:
+    static constexpr uint64_t kPrime = 1000000007;
+
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки известных последовательностей
+TEST_F(LinearRecurrenceTest, KnownSequences) {
+    std::vector<unsigned long long> fibonacci = {0, 1, 1, 2, 3, 5, 8, 13, 21, 34};
+    std::vector<unsigned long long> lucas = {2, 1, 3, 4, 7, 11, 18, 29, 47, 76};
+    std::vector<unsigned long long> pell = {0, 1, 2, 5, 12, 29, 70, 169, 408, 985};
+    std::vector<unsigned long long> tribonacci = {0, 0, 1, 1, 2, 4, 7, 13, 24, 44};
+
+    EXPECT_EQ(fibonacci, FibonacciRecurrence<>({0, 1}).generate(10));
+    EXPECT_EQ(lucas, FibonacciRecurrence<>({2, 1}).generate(10));
+    EXPECT_EQ(pell, PellRecurrence<>({0, 1}).generate(10));
+    EXPECT_EQ(tribonacci, TribonacciRecurrence<>({0, 0, 1}).generate(10));
+}
+
+// Тест для проверки коротких префиксов и некорректного аргумента
+TEST_F(LinearRecurrenceTest, ShortPrefixes) {
+    TribonacciRecurrence<> tribonacci({5, 6, 7});
+
+    EXPECT_EQ(std::vector<unsigned long long>({5}), tribonacci.generate(1));
+    EXPECT_EQ(std::vector<unsigned long long>({5, 6}), tribonacci.generate(2));
+    EXPECT_THROW((void)tribonacci.generate(0), std::invalid_argument);
+}
+
+// Тест для проверки, что метод Китамасы совпадает с последовательной генерацией
+TEST_F(LinearRecurrenceTest, TermMatchesGenerate) {
+    FibonacciRecurrence<> fibonacci({0, 1});
+    auto values = fibonacci.generate(93);
+    for (size_t n = 0; n < values.size(); ++n) {
+        EXPECT_EQ(values[n], fibonacci.term(n)) << "n = " << n;
+    }
+
+    LinearRecurrence<uint64_t, ModularArithmetic<kPrime>, 3, 0, 5, 7> custom({1, 2, 3, 4});
+    auto customValues = custom.generate(2000);
+    for (size_t n = 0; n < customValues.size(); n += 7) {
+        EXPECT_EQ(customValues[n], custom.term(n)) << "n = " << n;
+    }
+}
+
+// Тест для проверки переполнения с проверкой
+TEST_F(LinearRecurrenceTest, CheckedOverflow) {
+    FibonacciRecurrence<> fibonacci({0, 1});
+
+    EXPECT_NO_THROW((void)fibonacci.generate(94));
+    EXPECT_THROW((void)fibonacci.generate(95), std::overflow_error);
+    EXPECT_EQ(12200160415121876738ULL, fibonacci.term(93));
+    EXPECT_THROW((void)fibonacci.term(94), std::overflow_error);
+
+    FibonacciRecurrence<uint32_t> small({0, 1});
+    EXPECT_EQ(2971215073u, small.generate(48).back());
+    EXPECT_THROW((void)small.generate(49), std::overflow_error);
+}
+
+// Тест для проверки циклической арифметики по модулю 2^64
+TEST_F(LinearRecurrenceTest, Wrapping) {
+    FibonacciRecurrence<uint64_t, WrappingArithmetic> fibonacci({0, 1});
+    auto values = fibonacci.generate(300);
+
+    uint64_t previous = 0;
+    uint64_t current = 1;
+    for (size_t n = 0; n < values.size(); ++n) {
+        EXPECT_EQ(previous, values[n]) << "n = " << n;
+        uint64_t next = previous + current;
+        previous = current;
+        current = next;
+    }
+    EXPECT_EQ(values[299], fibonacci.term(299));
+}
+
+// Тест для проверки модульной арифметики на огромных номерах:
+// F(2n) = F(n) * (2F(n+1) - F(n))
+TEST_F(LinearRecurrenceTest, ModularHugeIndex) {
+    FibonacciRecurrence<uint64_t, ModularArithmetic<kPrime>> fibonacci({0, 1});
+
+    for (unsigned long long n : {1000ULL, 123456789ULL, 1000000000000000000ULL}) {
+        uint64_t current = fibonacci.term(n);
+        uint64_t next = fibonacci.term(n + 1);
+        uint64_t doubled = current * ((2 * next + kPrime - current) % kPrime) % kPrime;
+        EXPECT_EQ(doubled, fibonacci.term(2 * n)) << "n = " << n;
+    }
+}
+
+// Тест производительности генерации и вычисления отдельного члена
+TEST_F(LinearRecurrenceTest, Performance) {
+    TribonacciRecurrence<uint64_t, ModularArithmetic<kPrime>> tribonacci({0, 0, 1});
+
+    auto startGenerate = std::chrono::high_resolution_clock::now();
+    auto values = tribonacci.generate(10000000);
+    auto endGenerate = std::chrono::high_resolution_clock::now();
+
+    auto startTerm = std::chrono::high_resolution_clock::now();
+    uint64_t checksum = 0;
+    for (int i = 0; i < 1000; ++i) {
+        checksum = (checksum + tribonacci.term(1000000000000000000ULL + i)) % kPrime;
+    }
+    auto endTerm = std::chrono::high_resolution_clock::now();
+
+    auto durationGenerate = std::chrono::duration_cast<std::chrono::milliseconds>(endGenerate - startGenerate).count();
+    auto durationTerm = std::chrono::duration_cast<std::chrono::microseconds>(endTerm - startTerm).count();
+    std::cout << "Генерация 10^7 членов: " << durationGenerate << " мс, 1000 членов с номером ~10^18: "
+              << durationTerm << " мкс (контрольная сумма " << checksum << ")" << std::endl;
+
+    EXPECT_EQ(values.back(), tribonacci.term(values.size() - 1));
+}
+
+// Тест для проверки бюджета выделений памяти: генерация выделяет только вектор
+// результата, вычисление отдельного члена работает на стеке
+TEST_F(LinearRecurrenceTest, AllocationBudget) {
+    TribonacciRecurrence<uint64_t, ModularArithmetic<kPrime>> tribonacci({0, 0, 1});
+
+    std::vector<uint64_t> values;
+    EXPECT_LE(countAllocations([&] { values = tribonacci.generate(1000); }), 1u);
+
+    uint64_t term = 0;
+    EXPECT_EQ(0u, countAllocations([&] { term = tribonacci.term(999); }));
+    EXPECT_EQ(values.back(), term);
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,131 +1,24 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <string>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <memory>
 #include "linked_list.h"
+#include "allocation_counter.h"
+#include "perf_counters.h"
 
 class LinkedListTest : public ::testing::Test {
 protected:
     void SetUp() override {
         // Настройка перед каждым тестом
-        // Проверяем размер
-    EXPECT_EQ(5, list.size());
-    
-    // Проверяем содержимое
-    auto vec = list.toVector();
-    ASSERT_EQ(5, vec.size());
-    EXPECT_EQ(10, vec[0]);
-    EXPECT_EQ(20, vec[1]);
-    EXPECT_EQ(30, vec[2]);
-    EXPECT_EQ(40, vec[3]);
-    EXPECT_EQ(50, vec[4]);
-}
-
-// Тест для проверки метода reverseCopy
-TEST_F(LinkedListTest, ReverseCopy) {
-    LinkedList<int> original;
-    original.pushBack(1);
-    original.pushBack(2);
-    original.pushBack(3);
-    
-    // Создаем копию с развернутым порядком
-    LinkedList<int> reversed = LinkedList<int>::reverseCopy(original);
-    
-    // Проверяем, что исходный список не изменился
-    auto origVec = original.toVector();
-    ASSERT_EQ(3, origVec.size());
-    EXPECT_EQ(1, origVec[0]);
-    EXPECT_EQ(2, origVec[1]);
-    EXPECT_EQ(3, origVec[2]);
-    
-    // Проверяем, что копия содержит элементы в обратном порядке
-    auto revVec = reversed.toVector();
-    ASSERT_EQ(3, revVec.size());
-    EXPECT_EQ(3, revVec[0]);
-    EXPECT_EQ(2, revVec[1]);
-    EXPECT_EQ(1, revVec[2]);
-}
-
-// Тест для проверки очистки списка
-TEST_F(LinkedListTest, ClearList) {
-    LinkedList<int> list;
-    list.pushBack(1);
-    list.pushBack(2);
-    list.pushBack(3);
-    
-    EXPECT_EQ(3, list.size());
-    
-    list.clear();
-    
-    EXPECT_TRUE(list.isEmpty());
-    EXPECT_EQ(0, list.size());
-    EXPECT_EQ(nullptr, list.getHead());
-}
-
-// Тест для проверки работы с другими типами данных
-TEST_F(LinkedListTest, StringList) {
-    LinkedList<std::string> list;
-    list.pushBack("Hello");
-    list.pushBack("World");
-    list.pushBack("C++");
-    
-    EXPECT_EQ(3, list.size());
-    
-    auto head = list.getHead();
-    ASSERT_NE(nullptr, head);
-    EXPECT_EQ("Hello", head->data);
-    
-    // Разворачиваем список
-    auto reversed = list.reverse();
-    
-    // Проверяем развернутый список
-    ASSERT_NE(nullptr, reversed);
-    EXPECT_EQ("C++", reversed->data);
-    
-    ASSERT_NE(nullptr, reversed->next);
-    EXPECT_EQ("World", reversed->next->data);
-    
-    ASSERT_NE(nullptr, reversed->next->next);
-    EXPECT_EQ("Hello", reversed->next->next->data);
-    
-    EXPECT_EQ(nullptr, reversed->next->next->next);
-}
-
-// Тест для проверки производительности
-TEST_F(LinkedListTest, Performance) {
-    // Создаем большой список для тестирования производительности
-    LinkedList<int> list;
-    const int SIZE = 10000;
-    
-    // Замеряем время добавления элементов
-    auto startPush = std::chrono::high_resolution_clock::now();
-    for (int i = 0; i < SIZE; ++i) {
-        list.pushBack(i);
     }
-    auto endPush = std::chrono::high_resolution_clock::now();
-    auto durationPush = std::chrono::duration_cast<std::chrono::milliseconds>(endPush - startPush).count();
-    
-    // Проверяем, что все элементы добавлены корректно
-    EXPECT_EQ(SIZE, list.size());
-    
-    // Замеряем время разворота списка
-    auto startReverse = std::chrono::high_resolution_clock::now();
-    list.reverse();
-    auto endReverse = std::chrono::high_resolution_clock::now();
-    auto durationReverse = std::chrono::duration_cast<std::chrono::milliseconds>(endReverse - startReverse).count();
-    
-    // Проверяем, что размер не изменился
-    EXPECT_EQ(SIZE, list.size());
-    
-    // Выводим информацию о времени выполнения (для информации)
-    std::cout << "Время добавления " << SIZE << " элементов: " << durationPush << " мс\n";
-    std::cout << "Время разворота списка из " << SIZE << " элементов: " << durationReverse << " мс\n";
-}
-
-// Функция main является необязательной, если вы используете gtest_main
-int main(int argc, char **argv) {
-    ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
-}
     
     void TearDown() override {
         // Очистка после каждого теста
@@ -298,4 +191,1052 @@ TEST_F(LinkedListTest, ReverseTwice) {
 // Тест для проверки создания списка из вектора
 TEST_F(LinkedListTest, CreateFromVector) {
     std::vector<int> values = {10, 20, 30, 40, 50};
-    LinkedList<int> list(values);
\ No newline at end of file
+    LinkedList<int> list(values);
+    
+    // Проверяем размер
+    EXPECT_EQ(5, list.size());
+    
+    // Проверяем содержимое
+    auto vec = list.toVector();
+    ASSERT_EQ(5, vec.size());
+    EXPECT_EQ(10, vec[0]);
+    EXPECT_EQ(20, vec[1]);
+    EXPECT_EQ(30, vec[2]);
+    EXPECT_EQ(40, vec[3]);
+    EXPECT_EQ(50, vec[4]);
+}
+
+// Тест для проверки метода reverseCopy
+TEST_F(LinkedListTest, ReverseCopy) {
+    LinkedList<int> original;
+    original.pushBack(1);
+    original.pushBack(2);
+    original.pushBack(3);
+    
+    // Создаем копию с развернутым порядком
+    LinkedList<int> reversed = LinkedList<int>::reverseCopy(original);
+    
+    // Проверяем, что исходный список не изменился
+    auto origVec = original.toVector();
+    ASSERT_EQ(3, origVec.size());
+    EXPECT_EQ(1, origVec[0]);
+    EXPECT_EQ(2, origVec[1]);
+    EXPECT_EQ(3, origVec[2]);
+    
+    // Проверяем, что копия содержит элементы в обратном порядке
+    auto revVec = reversed.toVector();
+    ASSERT_EQ(3, revVec.size());
+    EXPECT_EQ(3, revVec[0]);
+    EXPECT_EQ(2, revVec[1]);
+    EXPECT_EQ(1, revVec[2]);
+}
+
+// Тест для проверки очистки списка
+TEST_F(LinkedListTest, ClearList) {
+    LinkedList<int> list;
+    list.pushBack(1);
+    list.pushBack(2);
+    list.pushBack(3);
+    
+    EXPECT_EQ(3, list.size());
+    
+    list.clear();
+    
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(0, list.size());
+    EXPECT_EQ(nullptr, list.getHead());
+}
+
+// Тест для проверки работы с другими типами данных
+TEST_F(LinkedListTest, StringList) {
+    LinkedList<std::string> list;
+    list.pushBack("Hello");
+    list.pushBack("World");
+    list.pushBack("C++");
+    
+    EXPECT_EQ(3, list.size());
+    
+    auto head = list.getHead();
+    ASSERT_NE(nullptr, head);
+    EXPECT_EQ("Hello", head->data);
+    
+    // Разворачиваем список
+    auto reversed = list.reverse();
+    
+    // Проверяем развернутый список
+    ASSERT_NE(nullptr, reversed);
+    EXPECT_EQ("C++", reversed->data);
+    
+    ASSERT_NE(nullptr, reversed->next);
+    EXPECT_EQ("World", reversed->next->data);
+    
+    ASSERT_NE(nullptr, reversed->next->next);
+    EXPECT_EQ("Hello", reversed->next->next->data);
+    
+    EXPECT_EQ(nullptr, reversed->next->next->next);
+}
+
+// Тест для проверки производительности
+TEST_F(LinkedListTest, Performance) {
+    // Создаем большой список для тестирования производительности
+    LinkedList<int> list;
+    const int SIZE = 10000;
+    
+    // Аппаратные счетчики показывают, упирается ли обход узлов в задержку памяти
+    PerfCounters counters;
+    
+    // Замеряем время добавления элементов
+    auto startPush = std::chrono::high_resolution_clock::now();
+    auto pushCounters = counters.measure([&] {
+        for (int i = 0; i < SIZE; ++i) {
+            list.pushBack(i);
+        }
+    });
+    auto endPush = std::chrono::high_resolution_clock::now();
+    auto durationPush = std::chrono::duration_cast<std::chrono::milliseconds>(endPush - startPush).count();
+    
+    // Проверяем, что все элементы добавлены корректно
+    EXPECT_EQ(SIZE, list.size());
+    
+    // Замеряем время разворота списка
+    auto startReverse = std::chrono::high_resolution_clock::now();
+    auto reverseCounters = counters.measure([&] { list.reverse(); });
+    auto endReverse = std::chrono::high_resolution_clock::now();
+    auto durationReverse = std::chrono::duration_cast<std::chrono::milliseconds>(endReverse - startReverse).count();
+    
+    // Проверяем, что размер не изменился
+    EXPECT_EQ(SIZE, list.size());
+    
+    // Обход по указателям next без копирования shared_ptr
+    long long sum = 0;
+    auto traversalCounters = counters.measure([&] {
+        for (const auto* node = list.getHead().get(); node; node = node->next.get()) {
+            sum += node->data;
+        }
+    });
+    EXPECT_EQ(static_cast<long long>(SIZE) * (SIZE - 1) / 2, sum);
+    
+    // Выводим информацию о времени выполнения (для информации)
+    std::cout << "Время добавления " << SIZE << " элементов: " << durationPush << " мс\n";
+    std::cout << "Время разворота списка из " << SIZE << " элементов: " << durationReverse << " мс\n";
+    PerfCounters::report(std::cout, "Добавление", pushCounters, SIZE);
+    PerfCounters::report(std::cout, "Разворот", reverseCounters, SIZE);
+    PerfCounters::report(std::cout, "Обход", traversalCounters, SIZE);
+}
+
+// Тест для проверки бинарной сериализации списка чисел
+TEST_F(LinkedListTest, SaveLoadTrivialType) {
+    std::string path = ::testing::TempDir() + "linked_list_ints.bin";
+    LinkedList<long long> list(std::vector<long long>{5, -7, 1LL << 40, 0});
+    
+    list.save(path);
+    auto loaded = LinkedList<long long>::load(path);
+    
+    EXPECT_EQ(list.size(), loaded.size());
+    EXPECT_EQ(list.toVector(), loaded.toVector());
+    std::remove(path.c_str());
+}
+
+// Тест для проверки бинарной сериализации списка строк
+TEST_F(LinkedListTest, SaveLoadStrings) {
+    std::string path = ::testing::TempDir() + "linked_list_strings.bin";
+    std::string longValue(100000, 'x');
+    LinkedList<std::string> list(std::vector<std::string>{"Hello", "", longValue, "C++"});
+    
+    list.save(path);
+    auto loaded = LinkedList<std::string>::load(path);
+    
+    EXPECT_EQ(list.toVector(), loaded.toVector());
+    std::remove(path.c_str());
+}
+
+// Тест для проверки сериализации пустого списка
+TEST_F(LinkedListTest, SaveLoadEmptyList) {
+    std::string path = ::testing::TempDir() + "linked_list_empty.bin";
+    LinkedList<int> list;
+    
+    list.save(path);
+    auto loaded = LinkedList<int>::load(path);
+    
+    EXPECT_TRUE(loaded.isEmpty());
+    EXPECT_EQ(nullptr, loaded.getHead());
+    std::remove(path.c_str());
+}
+
+// Тест для проверки отказа загрузки файла другого типа или формата
+TEST_F(LinkedListTest, LoadRejectsMismatchedFile) {
+    std::string path = ::testing::TempDir() + "linked_list_mismatch.bin";
+    LinkedList<int> list(std::vector<int>{1, 2, 3});
+    list.save(path);
+    
+    EXPECT_THROW(LinkedList<long long>::load(path), std::runtime_error);
+    EXPECT_THROW(LinkedList<std::string>::load(path), std::runtime_error);
+    
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "garbage";
+    EXPECT_THROW(LinkedList<int>::load(path), std::runtime_error);
+    EXPECT_THROW(LinkedList<int>::load(path + ".missing"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+// Тест для проверки отказа загрузки файла строк с испорченным числом элементов
+TEST_F(LinkedListTest, LoadRejectsCorruptStringCount) {
+    std::string path = ::testing::TempDir() + "linked_list_corrupt.bin";
+    LinkedList<std::string> list(std::vector<std::string>{"alpha", "beta"});
+    list.save(path);
+
+    // Число элементов - последнее поле заголовка (16 байт до него)
+    for (uint64_t count : {uint64_t(1000), uint64_t(1) << 61, UINT64_MAX}) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(16);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.close();
+        EXPECT_THROW(LinkedList<std::string>::load(path), std::runtime_error) << count;
+    }
+    std::remove(path.c_str());
+
+    // Блок арены, размер которого не выражается в size_t, не выделяется
+    NodeArena arena(SIZE_MAX / 8);
+    EXPECT_THROW(arena.allocate(64, 8), std::length_error);
+}
+
+// Тест для проверки загрузки тривиально копируемого типа без конструктора по умолчанию
+TEST_F(LinkedListTest, SaveLoadWithoutDefaultConstructor) {
+    struct Point {
+        int x;
+        int y;
+
+        Point(int px, int py) : x(px), y(py) {}
+    };
+
+    std::string path = ::testing::TempDir() + "linked_list_points.bin";
+    LinkedList<Point> list;
+    for (int i = 0; i < 40; ++i) {
+        list.pushBack(Point(i, -i));
+    }
+    list.save(path);
+
+    auto loaded = LinkedList<Point>::load(path);
+    ASSERT_EQ(40u, loaded.size());
+    int i = 0;
+    for (const auto* node = loaded.getHead().get(); node; node = node->next.get(), ++i) {
+        EXPECT_EQ(i, node->data.x);
+        EXPECT_EQ(-i, node->data.y);
+    }
+    std::remove(path.c_str());
+}
+
+// Тест производительности сохранения и загрузки большого списка
+TEST_F(LinkedListTest, SerializationPerformance) {
+    std::string path = ::testing::TempDir() + "linked_list_perf.bin";
+    const int SIZE = 1000000;
+    
+    LinkedList<int> list;
+    for (int i = SIZE - 1; i >= 0; --i) {
+        list.pushFront(i);
+    }
+    
+    auto startSave = std::chrono::high_resolution_clock::now();
+    list.save(path);
+    auto endSave = std::chrono::high_resolution_clock::now();
+    auto durationSave = std::chrono::duration_cast<std::chrono::milliseconds>(endSave - startSave).count();
+    
+    auto startLoad = std::chrono::high_resolution_clock::now();
+    auto loaded = LinkedList<int>::load(path);
+    auto endLoad = std::chrono::high_resolution_clock::now();
+    auto durationLoad = std::chrono::duration_cast<std::chrono::milliseconds>(endLoad - startLoad).count();
+    
+    EXPECT_EQ(SIZE, loaded.size());
+    EXPECT_EQ(list.toVector(), loaded.toVector());
+    std::remove(path.c_str());
+    
+    std::cout << "Время сохранения " << SIZE << " элементов: " << durationSave << " мс\n";
+    std::cout << "Время загрузки " << SIZE << " элементов: " << durationLoad << " мс\n";
+}
+
+// Тест для проверки сортировки слиянием
+TEST_F(LinkedListTest, SortRelinksNodes) {
+    LinkedList<int> list(std::vector<int>{5, 3, 9, 1, 4, 1, 8, 2, 7});
+    auto head = list.getHead();
+    
+    list.sort();
+    
+    EXPECT_EQ(std::vector<int>({1, 1, 2, 3, 4, 5, 7, 8, 9}), list.toVector());
+    EXPECT_EQ(9, list.size());
+    
+    // Узел с 5 должен остаться тем же объектом, а не копией
+    auto current = list.getHead();
+    while (current && current->data != 5) {
+        current = current->next;
+    }
+    EXPECT_EQ(head, current);
+}
+
+// Тест для проверки сортировки с пользовательским компаратором
+TEST_F(LinkedListTest, SortDescending) {
+    LinkedList<int> list(std::vector<int>{1, 2, 3, 4, 5, 6});
+    
+    list.sort(std::greater<int>());
+    
+    EXPECT_EQ(std::vector<int>({6, 5, 4, 3, 2, 1}), list.toVector());
+}
+
+// Тест для проверки устойчивости сортировки
+TEST_F(LinkedListTest, SortIsStable) {
+    using Item = std::pair<int, int>;
+    LinkedList<Item> list;
+    for (int i = 0; i < 100; ++i) {
+        list.pushBack(Item(i % 7, i));
+    }
+    
+    list.sort([](const Item& a, const Item& b) { return a.first < b.first; });
+    
+    auto vec = list.toVector();
+    ASSERT_EQ(100, vec.size());
+    for (size_t i = 1; i < vec.size(); ++i) {
+        ASSERT_LE(vec[i - 1].first, vec[i].first);
+        if (vec[i - 1].first == vec[i].first) {
+            EXPECT_LT(vec[i - 1].second, vec[i].second);
+        }
+    }
+}
+
+// Тест для проверки сортировки пустого списка и списка из одного элемента
+TEST_F(LinkedListTest, SortTrivialLists) {
+    LinkedList<int> empty;
+    empty.sort();
+    EXPECT_TRUE(empty.isEmpty());
+    
+    LinkedList<int> single;
+    single.pushBack(42);
+    single.sort();
+    EXPECT_EQ(std::vector<int>({42}), single.toVector());
+}
+
+// Тест для проверки слияния отсортированных списков
+TEST_F(LinkedListTest, MergeSortedLists) {
+    LinkedList<int> first(std::vector<int>{1, 4, 6, 10});
+    LinkedList<int> second(std::vector<int>{2, 4, 5, 11, 12});
+    
+    first.merge(std::move(second));
+    
+    EXPECT_EQ(std::vector<int>({1, 2, 4, 4, 5, 6, 10, 11, 12}), first.toVector());
+    EXPECT_EQ(9, first.size());
+    EXPECT_TRUE(second.isEmpty());
+    EXPECT_EQ(nullptr, second.getHead());
+    
+    LinkedList<int> empty;
+    first.merge(std::move(empty));
+    EXPECT_EQ(9, first.size());
+    
+    empty.merge(std::move(first));
+    EXPECT_EQ(9, empty.size());
+    EXPECT_TRUE(first.isEmpty());
+}
+
+// Тест производительности сортировки на месте в сравнении с сортировкой через вектор
+// (10^7 элементов сравниваются в замерах linked_list/sortLarge*)
+TEST_F(LinkedListTest, SortPerformance) {
+    const int SIZE = 100000;
+    
+    // Детерминированная псевдослучайная последовательность
+    std::vector<int> values(SIZE);
+    unsigned int state = 12345;
+    for (auto& value : values) {
+        state = state * 1103515245u + 12345u;
+        value = static_cast<int>(state >> 1);
+    }
+    
+    LinkedList<int> list;
+    for (auto it = values.rbegin(); it != values.rend(); ++it) {
+        list.pushFront(*it);
+    }
+    
+    // Сортировка через вектор: toVector, std::sort и новый список
+    auto startVector = std::chrono::high_resolution_clock::now();
+    auto vec = list.toVector();
+    std::sort(vec.begin(), vec.end());
+    LinkedList<int> rebuilt;
+    for (auto it = vec.rbegin(); it != vec.rend(); ++it) {
+        rebuilt.pushFront(*it);
+    }
+    auto endVector = std::chrono::high_resolution_clock::now();
+    auto durationVector = std::chrono::duration_cast<std::chrono::milliseconds>(endVector - startVector).count();
+    
+    // Сортировка перестановкой узлов
+    auto startInPlace = std::chrono::high_resolution_clock::now();
+    list.sort();
+    auto endInPlace = std::chrono::high_resolution_clock::now();
+    auto durationInPlace = std::chrono::duration_cast<std::chrono::milliseconds>(endInPlace - startInPlace).count();
+    
+    EXPECT_EQ(SIZE, list.size());
+    EXPECT_EQ(vec, list.toVector());
+    
+    std::cout << "Сортировка " << SIZE << " элементов через вектор: " << durationVector << " мс\n";
+    std::cout << "Сортировка " << SIZE << " элементов на месте: " << durationInPlace << " мс\n";
+}
+
+// Тест для проверки разворота отрезка списка
+TEST_F(LinkedListTest, ReverseRange) {
+    LinkedList<int> list(std::vector<int>{0, 1, 2, 3, 4, 5, 6});
+    
+    list.reverseRange(2, 5);
+    EXPECT_EQ(std::vector<int>({0, 1, 4, 3, 2, 5, 6}), list.toVector());
+    
+    auto head = list.reverseRange(0, 7);
+    EXPECT_EQ(std::vector<int>({6, 5, 2, 3, 4, 1, 0}), list.toVector());
+    EXPECT_EQ(6, head->data);
+    
+    list.reverseRange(5, 7);
+    EXPECT_EQ(std::vector<int>({6, 5, 2, 3, 4, 0, 1}), list.toVector());
+    EXPECT_EQ(7, list.size());
+}
+
+// Тест для проверки вырожденных и некорректных отрезков
+TEST_F(LinkedListTest, ReverseRangeBounds) {
+    LinkedList<int> list(std::vector<int>{1, 2, 3});
+    
+    list.reverseRange(1, 1);
+    list.reverseRange(2, 3);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), list.toVector());
+    
+    EXPECT_THROW(list.reverseRange(2, 1), std::out_of_range);
+    EXPECT_THROW(list.reverseRange(0, 4), std::out_of_range);
+    
+    LinkedList<int> empty;
+    EXPECT_EQ(nullptr, empty.reverseRange(0, 0));
+}
+
+// Тест для проверки разворота групп по k узлов
+TEST_F(LinkedListTest, ReverseInGroups) {
+    LinkedList<int> list(std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8});
+    
+    list.reverseInGroups(3);
+    EXPECT_EQ(std::vector<int>({3, 2, 1, 6, 5, 4, 7, 8}), list.toVector());
+    
+    list.reverseInGroups(3);
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}), list.toVector());
+    
+    list.reverseInGroups(2);
+    EXPECT_EQ(std::vector<int>({2, 1, 4, 3, 6, 5, 8, 7}), list.toVector());
+    
+    list.reverseInGroups(8);
+    EXPECT_EQ(std::vector<int>({7, 8, 5, 6, 3, 4, 1, 2}), list.toVector());
+    
+    list.reverseInGroups(9);
+    list.reverseInGroups(1);
+    EXPECT_EQ(std::vector<int>({7, 8, 5, 6, 3, 4, 1, 2}), list.toVector());
+    EXPECT_EQ(8, list.size());
+    
+    EXPECT_THROW(list.reverseInGroups(0), std::invalid_argument);
+}
+
+// Тест производительности разворота отрезков и групп на большом списке
+TEST_F(LinkedListTest, GroupReversePerformance) {
+    const int SIZE = 1000000;
+    
+    std::vector<int> expected(SIZE);
+    LinkedList<int> list;
+    for (int i = SIZE - 1; i >= 0; --i) {
+        expected[i] = i;
+        list.pushFront(i);
+    }
+    
+    for (size_t k : {2u, 16u, 256u, 65536u}) {
+        auto start = std::chrono::high_resolution_clock::now();
+        list.reverseInGroups(k);
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        
+        for (size_t groupStart = 0; groupStart + k <= expected.size(); groupStart += k) {
+            std::reverse(expected.begin() + groupStart, expected.begin() + groupStart + k);
+        }
+        
+        std::cout << "Разворот групп по " << k << " в списке из " << SIZE << " элементов: "
+                  << duration << " мс\n";
+    }
+    EXPECT_EQ(expected, list.toVector());
+    
+    auto startRange = std::chrono::high_resolution_clock::now();
+    list.reverseRange(SIZE / 4, SIZE - SIZE / 4);
+    auto endRange = std::chrono::high_resolution_clock::now();
+    auto durationRange = std::chrono::duration_cast<std::chrono::milliseconds>(endRange - startRange).count();
+    
+    std::reverse(expected.begin() + SIZE / 4, expected.end() - SIZE / 4);
+    EXPECT_EQ(expected, list.toVector());
+    
+    std::cout << "Разворот отрезка из " << SIZE / 2 << " элементов: " << durationRange << " мс\n";
+}
+
+// Тест для проверки бюджета выделений памяти: добавление элемента выделяет один блок
+// (узел вместе со счетчиком ссылок), перестановки узлов память не выделяют
+TEST_F(LinkedListTest, AllocationBudget) {
+    LinkedList<int> list;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_LE(countAllocations([&] { list.pushBack(i); }), 1u);
+    }
+    EXPECT_LE(countAllocations([&] { list.pushFront(-1); }), 1u);
+
+    // Первая выдача головы наружу переносит встроенные узлы в кучу
+    EXPECT_EQ(LinkedList<int>::kInlineCapacity, countAllocations([&] { (void)list.getHead(); }));
+    EXPECT_EQ(0u, countAllocations([&] { list.reverse(); }));
+    EXPECT_EQ(0u, countAllocations([&] { list.reverseRange(10, 20); }));
+    EXPECT_EQ(0u, countAllocations([&] { list.reverseInGroups(7); }));
+    EXPECT_EQ(0u, countAllocations([&] { list.sort(); }));
+
+    std::vector<int> values;
+    EXPECT_LE(countAllocations([&] { values = list.toVector(); }), 1u);
+    EXPECT_EQ(101u, values.size());
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+// Тест для проверки доступа, вставки и удаления по позиции с индексом и без него
+TEST_F(LinkedListTest, PositionalAccess) {
+    for (bool indexed : {false, true}) {
+        LinkedList<int> list;
+        std::vector<int> model;
+        if (indexed) {
+            list.enableIndex();
+        }
+        
+        std::mt19937 random(indexed ? 1 : 2);
+        for (int step = 0; step < 3000; ++step) {
+            size_t operation = random() % 4;
+            if (operation < 2 || model.empty()) {
+                size_t index = random() % (model.size() + 1);
+                list.insertAt(index, step);
+                model.insert(model.begin() + index, step);
+            } else if (operation == 2) {
+                size_t index = random() % model.size();
+                list.eraseAt(index);
+                model.erase(model.begin() + index);
+            } else {
+                size_t index = random() % model.size();
+                ASSERT_EQ(model[index], list.at(index)) << "index = " << index;
+                list.at(index) = -step;
+                model[index] = -step;
+            }
+        }
+        
+        EXPECT_EQ(model.size(), list.size());
+        EXPECT_EQ(model, list.toVector());
+        EXPECT_THROW((void)list.at(list.size()), std::out_of_range);
+        EXPECT_THROW(list.insertAt(list.size() + 1, 0), std::out_of_range);
+        EXPECT_THROW(list.eraseAt(list.size()), std::out_of_range);
+    }
+}
+
+// Тест для проверки, что индекс поддерживается всеми изменяющими операциями
+TEST_F(LinkedListTest, IndexMaintained) {
+    LinkedList<int> list;
+    list.enableIndex();
+    EXPECT_TRUE(list.hasIndex());
+    
+    std::vector<int> model;
+    auto check = [&](const char* operation) {
+        ASSERT_EQ(model.size(), list.size()) << operation;
+        for (size_t i = 0; i < model.size(); ++i) {
+            ASSERT_EQ(model[i], list.at(i)) << operation << ", i = " << i;
+        }
+    };
+    
+    for (int i = 0; i < 500; ++i) {
+        list.pushBack(i);
+        model.push_back(i);
+        list.pushFront(-i);
+        model.insert(model.begin(), -i);
+    }
+    check("pushBack/pushFront");
+    
+    list.reverse();
+    std::reverse(model.begin(), model.end());
+    check("reverse");
+    
+    list.reverseRange(100, 400);
+    std::reverse(model.begin() + 100, model.begin() + 400);
+    check("reverseRange");
+    
+    list.reverseInGroups(7);
+    for (size_t i = 0; i + 7 <= model.size(); i += 7) {
+        std::reverse(model.begin() + i, model.begin() + i + 7);
+    }
+    check("reverseInGroups");
+    
+    list.sort();
+    std::sort(model.begin(), model.end());
+    check("sort");
+    
+    LinkedList<int> other(std::vector<int>{-1000, 0, 1000});
+    other.enableIndex();
+    list.merge(std::move(other));
+    model.insert(model.end(), {-1000, 0, 1000});
+    std::stable_sort(model.begin(), model.end());
+    check("merge");
+    EXPECT_THROW((void)other.at(0), std::out_of_range);
+    
+    LinkedList<int> copy = list;
+    EXPECT_TRUE(copy.hasIndex());
+    EXPECT_EQ(model[model.size() / 2], copy.at(model.size() / 2));
+    
+    list.clear();
+    model.clear();
+    check("clear");
+    list.pushBack(5);
+    EXPECT_EQ(5, list.at(0));
+    
+    list.disableIndex();
+    EXPECT_FALSE(list.hasIndex());
+    EXPECT_EQ(5, list.at(0));
+}
+
+// Тест для проверки порядка обхода forEach для разных размеров
+TEST_F(LinkedListTest, ForEachOrder) {
+    for (int size : {0, 1, 2, 3, 5, 17, 100, 1001}) {
+        std::vector<int> values(size);
+        for (int i = 0; i < size; ++i) {
+            values[i] = i * 3 - size;
+        }
+        LinkedList<int> list(values);
+        
+        std::vector<int> plain;
+        list.forEach([&plain](int value) { plain.push_back(value); });
+        EXPECT_EQ(values, plain);
+        
+        list.enableIndex();
+        std::vector<int> scanned;
+        list.forEach([&scanned](int value) { scanned.push_back(value); });
+        EXPECT_EQ(values, scanned) << "size = " << size;
+    }
+}
+
+// Тест производительности доступа по позиции и обхода перемешанного списка
+TEST_F(LinkedListTest, IndexPerformance) {
+    const int SIZE = 200000;
+    const int QUERIES = 100;
+    
+    // После сортировки случайных чисел соседние узлы лежат в памяти вразброс
+    LinkedList<int> list;
+    std::mt19937 random(5);
+    for (int i = 0; i < SIZE; ++i) {
+        list.pushFront(static_cast<int>(random() % 1000000));
+    }
+    list.sort();
+    
+    auto measure = [&](const char* label) {
+        long long checksum = 0;
+        auto startAt = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < QUERIES; ++i) {
+            checksum += list.at(static_cast<size_t>(i) * 7919 % SIZE);
+        }
+        auto endAt = std::chrono::high_resolution_clock::now();
+        
+        auto startScan = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) {
+            list.forEach([&checksum](int value) { checksum += value; });
+        }
+        auto endScan = std::chrono::high_resolution_clock::now();
+        
+        auto durationAt = std::chrono::duration_cast<std::chrono::microseconds>(endAt - startAt).count();
+        auto durationScan = std::chrono::duration_cast<std::chrono::microseconds>(endScan - startScan).count();
+        std::cout << label << ": " << QUERIES << " вызовов at - " << durationAt << " мкс, 10 обходов - "
+                  << durationScan << " мкс (контрольная сумма " << checksum << ")\n";
+        return checksum;
+    };
+    
+    long long plain = measure("Без индекса");
+    auto startBuild = std::chrono::high_resolution_clock::now();
+    list.enableIndex();
+    auto endBuild = std::chrono::high_resolution_clock::now();
+    long long indexed = measure("С индексом");
+    
+    std::cout << "Построение индекса: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(endBuild - startBuild).count() << " мкс\n";
+    EXPECT_EQ(plain, indexed);
+}
+
+// Тест для проверки того, что операции над маленьким списком не выделяют память
+TEST_F(LinkedListTest, SmallListInlineStorage) {
+    const int SMALL = static_cast<int>(LinkedList<int>::kInlineCapacity);
+    LinkedList<int> list;
+    
+    EXPECT_EQ(0u, countAllocations([&] {
+        for (int i = 0; i < SMALL / 2; ++i) {
+            list.pushBack(i);
+        }
+        for (int i = SMALL / 2; i < SMALL; ++i) {
+            list.pushFront(i);
+        }
+        list.sort();
+        list.eraseAt(3);
+        list.insertAt(3, 100);
+    }));
+    
+    std::vector<int> expected(SMALL);
+    for (int i = 0; i < SMALL; ++i) {
+        expected[i] = i;
+    }
+    expected[3] = 100;
+    
+    size_t copySize = 0;
+    int movedHead = 0;
+    EXPECT_EQ(0u, countAllocations([&] {
+        LinkedList<int> reversed = LinkedList<int>::reverseCopy(list);
+        LinkedList<int> copy = list;
+        LinkedList<int> moved = std::move(reversed);
+        copySize = copy.size();
+        movedHead = moved.at(0);
+    }));
+    EXPECT_EQ(static_cast<size_t>(SMALL), copySize);
+    EXPECT_EQ(expected.back(), movedHead);
+    
+    std::vector<int> values;
+    EXPECT_EQ(1u, countAllocations([&] { values = list.toVector(); }));
+    EXPECT_EQ(expected, values);
+    
+    // Разворот выдает голову наружу, поэтому встроенные узлы переходят в кучу;
+    // дальше развороты памяти не выделяют
+    EXPECT_EQ(static_cast<size_t>(SMALL), countAllocations([&] { list.reverse(); }));
+    EXPECT_EQ(0u, countAllocations([&] { list.reverse(); }));
+    EXPECT_EQ(expected, list.toVector());
+    
+    // Узел сверх встроенных ячеек выделяется в куче
+    EXPECT_EQ(1u, countAllocations([&] { list.pushBack(SMALL); }));
+}
+
+// Тест проверяет, что голова, выданная наружу, владеет узлами и переживает список
+TEST_F(LinkedListTest, HeadOutlivesList) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 40; ++i) {
+        values.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    
+    std::shared_ptr<LinkedList<std::string>::Node> head;
+    std::shared_ptr<LinkedList<std::string>::Node> reversed;
+    {
+        LinkedList<std::string> list(values);
+        head = list.getHead();
+        // Узлы, добавленные после выдачи головы, тоже попадают в выданную цепочку
+        list.pushBack(std::string(40, 'z'));
+        LinkedList<std::string> second(values);
+        reversed = second.reverse();
+        LinkedList<std::string> moved(std::move(second));
+    }
+    
+    // Каждая ссылка цепочки владеет своим узлом
+    size_t count = 0;
+    for (auto node = head; node; node = node->next, ++count) {
+        ASSERT_GT(node.use_count(), 0) << "узел " << count;
+        if (count < values.size()) {
+            EXPECT_EQ(values[count], node->data);
+        }
+    }
+    EXPECT_EQ(values.size() + 1, count);
+    
+    count = 0;
+    for (auto node = reversed; node; node = node->next, ++count) {
+        ASSERT_GT(node.use_count(), 0) << "узел " << count;
+        EXPECT_EQ(values[values.size() - 1 - count], node->data);
+    }
+    EXPECT_EQ(values.size(), count);
+}
+
+// Тест для проверки списков, которые не помещаются во встроенные ячейки
+TEST_F(LinkedListTest, InlineStorageSpill) {
+    std::mt19937 random(11);
+    for (int size : {1, 15, 16, 17, 40, 300}) {
+        LinkedList<int> list;
+        std::vector<int> model;
+        for (int i = 0; i < size; ++i) {
+            int value = static_cast<int>(random() % 1000);
+            if (random() % 2) {
+                list.pushFront(value);
+                model.insert(model.begin(), value);
+            } else {
+                list.pushBack(value);
+                model.push_back(value);
+            }
+        }
+        // Удаление освобождает встроенные ячейки, вставка занимает их снова
+        for (int i = 0; i < size / 3; ++i) {
+            size_t index = random() % model.size();
+            list.eraseAt(index);
+            model.erase(model.begin() + index);
+            index = random() % (model.size() + 1);
+            list.insertAt(index, i);
+            model.insert(model.begin() + index, i);
+        }
+        EXPECT_EQ(model, list.toVector()) << "size = " << size;
+        
+        list.reverse();
+        std::reverse(model.begin(), model.end());
+        EXPECT_EQ(model, list.toVector());
+        
+        std::vector<int> reversedModel(model.rbegin(), model.rend());
+        EXPECT_EQ(reversedModel, LinkedList<int>::reverseCopy(list).toVector());
+        
+        // Копия не зависит от оригинала: оригинал уничтожается раньше копии
+        auto copy = std::make_unique<LinkedList<int>>(list);
+        LinkedList<int> second = *copy;
+        copy.reset();
+        EXPECT_EQ(model, second.toVector());
+        
+        // Перемещение переносит встроенные узлы, башни индекса переходят на их новые адреса
+        list.enableIndex();
+        std::vector<LinkedList<int>> lists;
+        lists.push_back(std::move(list));
+        lists.emplace_back(std::vector<int>{1, 2});
+        lists.emplace_back();
+        EXPECT_TRUE(list.isEmpty());
+        EXPECT_EQ(model, lists[0].toVector());
+        if (!model.empty()) {
+            EXPECT_EQ(model.back(), lists[0].at(model.size() - 1));
+        }
+        
+        // Слияние забирает встроенные узлы другого списка
+        std::sort(model.begin(), model.end());
+        lists[0].sort();
+        LinkedList<int> other(std::vector<int>{-1, 500, 2000});
+        lists[0].merge(std::move(other));
+        model.insert(model.begin(), -1);
+        model.insert(std::upper_bound(model.begin(), model.end(), 500), 500);
+        model.push_back(2000);
+        EXPECT_TRUE(other.isEmpty());
+        EXPECT_EQ(model, lists[0].toVector());
+    }
+}
+
+// Тест для проверки перемещения и копирующего присваивания списка с индексом
+TEST_F(LinkedListTest, IndexedMoveAndCopyAssignment) {
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) {
+        values[i] = i;
+    }
+    // Встроенные узлы в начале, в середине и в конце списка
+    LinkedList<int> list(values);
+    list.enableIndex();
+    for (int i = 0; i < 4; ++i) {
+        list.eraseAt(0);
+        values.erase(values.begin());
+    }
+    list.insertAt(500, -1);
+    values.insert(values.begin() + 500, -1);
+    list.pushBack(-2);
+    values.push_back(-2);
+    
+    // Перемещение не строит индекс заново и не выделяет память
+    LinkedList<int> moved;
+    EXPECT_EQ(0u, countAllocations([&] {
+        LinkedList<int> temporary(std::move(list));
+        moved = std::move(temporary);
+    }));
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], moved.at(i)) << "i = " << i;
+    }
+    moved.eraseAt(500);
+    values.erase(values.begin() + 500);
+    EXPECT_EQ(values, moved.toVector());
+    
+    struct Fragile {
+        int value;
+        
+        Fragile(int v) : value(v) {}
+        
+        Fragile(const Fragile& other) : value(other.value) {
+            if (value < 0) {
+                throw std::runtime_error("Сбой копирования");
+            }
+        }
+        
+        Fragile(Fragile&&) noexcept = default;
+        
+        Fragile& operator=(const Fragile&) = default;
+    };
+    
+    // Элементы перемещаются в список без копирования; сбой копирования элемента
+    // оставляет список, в который присваивают, без изменений
+    LinkedList<Fragile> target;
+    for (int i = 100; i-- > 0;) {
+        target.pushFront(Fragile(i));
+    }
+    target.enableIndex();
+    LinkedList<Fragile> source;
+    for (int i = 0; i < 50; ++i) {
+        source.pushFront(Fragile(i == 30 ? -1 : i));
+    }
+    EXPECT_THROW(target = source, std::runtime_error);
+    EXPECT_EQ(100u, target.size());
+    for (size_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(static_cast<int>(i), target.at(i).value);
+    }
+    
+    LinkedList<Fragile> valid;
+    for (int i = 0; i < 50; ++i) {
+        valid.pushFront(Fragile(i));
+    }
+    target = valid;
+    EXPECT_EQ(50u, target.size());
+    EXPECT_EQ(49, target.at(0).value);
+    EXPECT_EQ(0, target.at(49).value);
+}
+
+// Тест для проверки пакетного построения и добавления
+TEST_F(LinkedListTest, BulkAppend) {
+    for (size_t size : {size_t(0), size_t(1), size_t(16), size_t(17), size_t(1000), size_t(200000)}) {
+        std::vector<int> values(size);
+        for (size_t i = 0; i < size; ++i) {
+            values[i] = static_cast<int>(i * 7 % 1000);
+        }
+        LinkedList<int> list(values);
+        EXPECT_EQ(size, list.size());
+        EXPECT_EQ(values, list.toVector()) << "size = " << size;
+        
+        // Добавление к непустому списку с индексом
+        list.enableIndex();
+        std::vector<int> extra = {-1, -2, -3};
+        list.append(extra);
+        list.append(extra.begin(), extra.begin());
+        values.insert(values.end(), extra.begin(), extra.end());
+        EXPECT_EQ(values, list.toVector());
+        EXPECT_EQ(-3, list.at(values.size() - 1));
+    }
+    
+    std::vector<std::string> words = {"alpha", "beta", "gamma"};
+    LinkedList<std::string> strings;
+    strings.append(words.begin(), words.end());
+    strings.append(words);
+    EXPECT_EQ(6u, strings.size());
+    EXPECT_EQ("gamma", strings.at(5));
+    
+    // Отрезок одного потока: список отрезков, арена, ее список блоков и один блок под все узлы
+    std::vector<int> large(1000, 5);
+    LinkedList<int> list;
+    EXPECT_LE(countAllocations([&] { list.append(large); }), 4u);
+    EXPECT_EQ(large, list.toVector());
+}
+
+// Тест для проверки исключения при пакетном добавлении
+TEST_F(LinkedListTest, BulkAppendFailure) {
+    struct Fragile {
+        int value;
+        
+        Fragile(int v) : value(v) {}
+        
+        Fragile(const Fragile& other) : value(other.value) {
+            if (value < 0) {
+                throw std::runtime_error("Сбой копирования");
+            }
+        }
+        
+        Fragile& operator=(const Fragile&) = default;
+    };
+    
+    std::vector<Fragile> values(100000, Fragile(1));
+    values[90000] = Fragile(-1);
+    LinkedList<Fragile> list;
+    EXPECT_THROW(list.append(values), std::runtime_error);
+    // Встроенные ячейки успели заполниться, узлы в куче освобождены
+    EXPECT_EQ(LinkedList<Fragile>::kInlineCapacity, list.size());
+    
+    values[90000] = Fragile(1);
+    list.append(values);
+    EXPECT_EQ(LinkedList<Fragile>::kInlineCapacity + values.size(), list.size());
+}
+
+// Тест производительности пакетного построения списка
+TEST_F(LinkedListTest, BulkAppendPerformance) {
+    const int SIZE = 2000000;
+    std::vector<int> values(SIZE);
+    for (int i = 0; i < SIZE; ++i) {
+        values[i] = i;
+    }
+    
+    auto startCopy = std::chrono::high_resolution_clock::now();
+    std::vector<int> copy(values);
+    auto endCopy = std::chrono::high_resolution_clock::now();
+    
+    auto startPush = std::chrono::high_resolution_clock::now();
+    LinkedList<int> pushed;
+    for (int i = SIZE; i-- > 0;) {
+        pushed.pushFront(values[i]);
+    }
+    auto endPush = std::chrono::high_resolution_clock::now();
+    
+    auto startBulk = std::chrono::high_resolution_clock::now();
+    LinkedList<int> bulk(values);
+    auto endBulk = std::chrono::high_resolution_clock::now();
+    
+    EXPECT_EQ(copy, bulk.toVector());
+    EXPECT_EQ(pushed.toVector(), bulk.toVector());
+    
+    auto durationCopy = std::chrono::duration_cast<std::chrono::microseconds>(endCopy - startCopy).count();
+    auto durationPush = std::chrono::duration_cast<std::chrono::microseconds>(endPush - startPush).count();
+    auto durationBulk = std::chrono::duration_cast<std::chrono::microseconds>(endBulk - startBulk).count();
+    std::cout << "Построение списка из " << SIZE << " элементов: pushFront - " << durationPush
+              << " мкс, пакетно - " << durationBulk << " мкс, копия вектора - " << durationCopy << " мкс\n";
+}
+
+// Тест для проверки учета памяти: учтено ровно столько, сколько выделено
+TEST_F(LinkedListTest, MemoryUsage) {
+    // Короткий список целиком во встроенных ячейках
+    LinkedList<int> small;
+    small.pushFront(1);
+    EXPECT_EQ(sizeof(small), small.memoryUsage().total());
+
+    // Узлы в куче
+    LinkedList<int> heap;
+    AllocationScope heapScope;
+    for (int i = 0; i < 1000; ++i) {
+        heap.pushFront(i);
+    }
+    size_t heapBytes = heapScope.bytes();
+    EXPECT_EQ(heapBytes, heap.memoryUsage().nodes);
+    // Размер узла в куче считается один раз, повторный учет ничего не выделяет
+    EXPECT_EQ(0u, countAllocations([&] { (void)heap.memoryUsage(); }));
+
+    // Индекс
+    AllocationScope indexScope;
+    heap.enableIndex();
+    size_t indexBytes = indexScope.bytes();
+    EXPECT_EQ(indexBytes, heap.memoryUsage().index);
+
+    // Узлы в арене: встроенные ячейки и один блок
+    const int STREAMED = 1000;
+    LinkedList<int> streamed;
+    AllocationScope streamScope;
+    streamed.appendStream(STREAMED, [](auto&& emit) {
+        for (size_t i = 0; i < STREAMED + LinkedList<int>::kInlineCapacity; ++i) {
+            emit(static_cast<int>(i));
+        }
+    });
+    size_t streamBytes = streamScope.bytes();
+    EXPECT_EQ(streamBytes, streamed.memoryUsage().nodes);
+
+    // Арена перестает учитываться, когда в ней не остается узлов списка
+    while (!streamed.isEmpty()) {
+        streamed.eraseAt(0);
+    }
+    EXPECT_EQ(0u, streamed.memoryUsage().nodes);
+
+    // Перемещение и слияние переносят арены вместе с узлами. Встроенным узлам heap
+    // не хватает свободных встроенных ячеек, и они переходят в кучу
+    LinkedList<int> bulk(std::vector<int>(5000, 1));
+    size_t bulkBytes = bulk.memoryUsage().nodes;
+    LinkedList<int> moved(std::move(bulk));
+    EXPECT_EQ(bulkBytes, moved.memoryUsage().nodes);
+    size_t nodeBytes = heapBytes / (1000 - LinkedList<int>::kInlineCapacity);
+    moved.merge(std::move(heap));
+    EXPECT_EQ(bulkBytes + heapBytes + LinkedList<int>::kInlineCapacity * nodeBytes, moved.memoryUsage().nodes);
+    EXPECT_EQ(0u, heap.memoryUsage().nodes);
+
+    // Длинные строки владеют буфером в куче, короткие хранятся в самой строке
+    LinkedList<std::string> strings;
+    strings.pushFront("short");
+    strings.pushFront(std::string(100, 'x'));
+    EXPECT_EQ(strings.at(0).capacity() + 1, strings.memoryUsage().payload);
+}
+
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "list_view.h"
+#include "allocation_counter.h"
+
+class ListViewTest : public ::testing::Test {
+protected:
+    static LinkedList<int> makeList(int size) {
+        std::vector<int> values(size);
+        for (int i = 0; i < size; ++i) {
+            values[i] = i;
+        }
+        return LinkedList<int>(values);
+    }
+
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки цепочки map, filter и take
+TEST_F(ListViewTest, MapFilterTake) {
+    auto list = makeList(100);
+
+    auto result = ListViews::from(list)
+                      .filter([](int x) { return x % 3 == 0; })
+                      .map([](int x) { return x * 10; })
+                      .take(5)
+                      .toVector();
+    EXPECT_EQ(std::vector<int>({0, 30, 60, 90, 120}), result);
+
+    auto strings = ListViews::from(list).take(3).map([](int x) { return std::to_string(x) + "!"; }).collect();
+    EXPECT_EQ(std::vector<std::string>({"0!", "1!", "2!"}), strings.toVector());
+
+    EXPECT_EQ(100u, ListViews::from(list).sizeBound());
+    EXPECT_EQ(7u, ListViews::from(list).take(7).sizeBound());
+    EXPECT_TRUE(ListViews::from(list).take(0).toVector().empty());
+    EXPECT_TRUE(ListViews::from(LinkedList<int>()).map([](int x) { return x; }).collect().isEmpty());
+
+    // Исходный список не меняется
+    EXPECT_EQ(makeList(100).toVector(), list.toVector());
+}
+
+// Тест для проверки ленивости: стадии выполняются только в завершающей операции
+TEST_F(ListViewTest, LazyEvaluation) {
+    auto list = makeList(1000);
+    int calls = 0;
+
+    auto view = ListViews::from(list).map([&calls](int x) {
+        ++calls;
+        return x + 1;
+    });
+    auto firstThree = view.take(3);
+    EXPECT_EQ(0, calls);
+
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), firstThree.toVector());
+    // take прекращает проход после третьего элемента
+    EXPECT_EQ(3, calls);
+
+    // Представление отражает текущее содержимое списка
+    list.pushFront(-1);
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), firstThree.toVector());
+}
+
+// Тест для проверки обратного порядка
+TEST_F(ListViewTest, Reversed) {
+    auto list = makeList(10);
+
+    EXPECT_EQ(std::vector<int>({9, 8, 7}), ListViews::from(list).reversed().take(3).toVector());
+    EXPECT_EQ(std::vector<int>({2, 1, 0}), ListViews::from(list).take(3).reversed().toVector());
+    EXPECT_EQ(std::vector<int>({8, 6, 4, 2, 0}),
+              ListViews::from(list).filter([](int x) { return x % 2 == 0; }).reversed().toVector());
+    EXPECT_EQ(LinkedList<int>::reverseCopy(list).toVector(), ListViews::from(list).reversed().collect().toVector());
+    EXPECT_EQ(list.toVector(), ListViews::from(list).reversed().reversed().toVector());
+}
+
+// Тест для проверки бюджета выделений памяти при сборке в список
+TEST_F(ListViewTest, AllocationBudget) {
+    auto list = makeList(10000);
+    auto view = ListViews::from(list).map([](int x) { return x * 2; });
+
+    // Без преобразований память не выделяется
+    long long sum = 0;
+    EXPECT_EQ(0u, countAllocations([&] { view.forEach([&sum](int x) { sum += x; }); }));
+    EXPECT_EQ(99990000, sum);
+
+    // Арена, ее список блоков и один блок под все узлы
+    LinkedList<int> collected;
+    EXPECT_LE(countAllocations([&] { collected = view.collect(); }), 3u);
+    EXPECT_EQ(10000u, collected.size());
+
+    // С filter число элементов неизвестно: узлы берутся блоками по kCollectChunk,
+    // на каждый блок приходится не больше двух выделений (блок и рост списка блоков)
+    auto odd = ListViews::from(list).filter([](int x) { return x % 2 == 1; });
+    LinkedList<int> filtered;
+    size_t allocations = countAllocations([&] { filtered = odd.collect(); });
+    EXPECT_EQ(5000u, filtered.size());
+    EXPECT_LE(allocations, 1u + 2 * (5000 / decltype(odd)::kCollectChunk + 1));
+}
+
+// Тест производительности слитого прохода по сравнению с преобразованием через вектор
+TEST_F(ListViewTest, Performance) {
+    const int SIZE = 2000000;
+    auto list = makeList(SIZE);
+    auto even = [](int x) { return x % 2 == 0; };
+    auto triple = [](int x) { return x * 3; };
+
+    auto startRoundTrip = std::chrono::high_resolution_clock::now();
+    std::vector<int> values = list.toVector();
+    std::vector<int> selected;
+    std::copy_if(values.begin(), values.end(), std::back_inserter(selected), even);
+    std::transform(selected.begin(), selected.end(), selected.begin(), triple);
+    LinkedList<int> roundTrip(selected);
+    auto endRoundTrip = std::chrono::high_resolution_clock::now();
+
+    auto startView = std::chrono::high_resolution_clock::now();
+    LinkedList<int> fused = ListViews::from(list).filter(even).map(triple).collect();
+    auto endView = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(roundTrip.toVector(), fused.toVector());
+
+    auto durationRoundTrip = std::chrono::duration_cast<std::chrono::microseconds>(endRoundTrip - startRoundTrip).count();
+    auto durationView = std::chrono::duration_cast<std::chrono::microseconds>(endView - startView).count();
+    std::cout << "filter + map для " << SIZE << " элементов: через вектор " << durationRoundTrip
+              << " мкс, одним проходом " << durationView << " мкс" << std::endl;
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,12 +1,67 @@
 #include <gtest/gtest.h>
 #include <limits>
+#include <vector>
 #include "palindrome.h"
+#include "allocation_counter.h"
 
 class PalindromeTest : public ::testing::Test {
 protected:
     void SetUp() override {
         // Настройка перед каждым тестом
-    // Тест для проверки отрицательных чисел
+    }
+    
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тесты для строкового метода проверки палиндрома
+
+// Тест для проверки числа 0
+TEST_F(PalindromeTest, ZeroIsStringPalindrome) {
+    EXPECT_TRUE(PalindromeChecker::isPalindrome(0));
+}
+
+// Тест для проверки однозначных чисел
+TEST_F(PalindromeTest, SingleDigitsAreStringPalindromes) {
+    for (int i = 1; i <= 9; ++i) {
+        EXPECT_TRUE(PalindromeChecker::isPalindrome(i)) << "Ошибка для числа " << i;
+    }
+}
+
+// Тест для проверки двузначных палиндромов
+TEST_F(PalindromeTest, TwoDigitStringPalindromes) {
+    int palindromes[] = {11, 22, 33, 44, 55, 66, 77, 88, 99};
+    for (int num : palindromes) {
+        EXPECT_TRUE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+    }
+}
+
+// Тест для проверки двузначных не-палиндромов
+TEST_F(PalindromeTest, TwoDigitStringNonPalindromes) {
+    int nonPalindromes[] = {10, 12, 23, 34, 45, 56, 67, 78, 89};
+    for (int num : nonPalindromes) {
+        EXPECT_FALSE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+    }
+}
+
+// Тест для проверки многозначных палиндромов
+TEST_F(PalindromeTest, MultiDigitStringPalindromes) {
+    long long palindromes[] = {121, 12321, 123321, 1234321, 12344321};
+    for (long long num : palindromes) {
+        EXPECT_TRUE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+    }
+}
+
+// Тест для проверки многозначных не-палиндромов
+TEST_F(PalindromeTest, MultiDigitStringNonPalindromes) {
+    long long nonPalindromes[] = {123, 1232, 12345, 123456, 1234567};
+    for (long long num : nonPalindromes) {
+        EXPECT_FALSE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+    }
+}
+
+// Тест для проверки отрицательных чисел
 TEST_F(PalindromeTest, NegativeStringPalindromes) {
     long long numbers[] = {-121, -12321, -1234321};
     for (long long num : numbers) {
@@ -20,7 +75,8 @@ TEST_F(PalindromeTest, NegativeStringPalindromes) {
 TEST_F(PalindromeTest, VeryLargeStringPalindromes) {
     // Большие палиндромы
     EXPECT_TRUE(PalindromeChecker::isPalindrome(12345678987654321LL));
-    EXPECT_TRUE(PalindromeChecker::isPalindrome(9876543210123456789LL));
+    // Наибольший палиндром, который помещается в long long
+    EXPECT_TRUE(PalindromeChecker::isPalindrome(9223372036302733229LL));
 }
 
 // Тесты для числового метода проверки палиндрома
@@ -112,59 +168,242 @@ TEST_F(PalindromeTest, Performance) {
     std::cout << "Время выполнения числового метода: " << numericDuration << " микросекунд\n";
 }
 
-// Функция main является необязательной, если вы используете gtest_main
-int main(int argc, char **argv) {
-    ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+// Тест для проверки поиска соседних палиндромов перебором на небольшом диапазоне
+TEST_F(PalindromeTest, NextPrevNearestMatchBruteForce) {
+    for (long long num = -3000; num <= 3000; ++num) {
+        long long next = num;
+        while (!PalindromeChecker::isPalindrome(next)) {
+            ++next;
+        }
+        long long prev = num;
+        while (!PalindromeChecker::isPalindrome(prev)) {
+            --prev;
+        }
+        long long nearest = (next - num < num - prev) ? next : prev;
+        
+        EXPECT_EQ(next, PalindromeChecker::nextPalindrome(num)) << "Ошибка для числа " << num;
+        EXPECT_EQ(prev, PalindromeChecker::prevPalindrome(num)) << "Ошибка для числа " << num;
+        EXPECT_EQ(nearest, PalindromeChecker::nearestPalindrome(num)) << "Ошибка для числа " << num;
+    }
 }
+
+// Тест для проверки переносов и заемов между разрядами
+TEST_F(PalindromeTest, NextPrevCarryHandling) {
+    EXPECT_EQ(101, PalindromeChecker::nextPalindrome(100));
+    EXPECT_EQ(1001, PalindromeChecker::nextPalindrome(1000));
+    EXPECT_EQ(100001, PalindromeChecker::nextPalindrome(99999 + 1));
+    EXPECT_EQ(1000000001LL, PalindromeChecker::nextPalindrome(999999999LL + 1));
+    EXPECT_EQ(12921, PalindromeChecker::nextPalindrome(12921));
+    EXPECT_EQ(13031, PalindromeChecker::nextPalindrome(12922));
+    EXPECT_EQ(99999, PalindromeChecker::prevPalindrome(100000));
+    EXPECT_EQ(999, PalindromeChecker::prevPalindrome(1000));
+    EXPECT_EQ(9, PalindromeChecker::prevPalindrome(10));
+    EXPECT_EQ(1991, PalindromeChecker::nextPalindrome(1901));
+    EXPECT_EQ(1881, PalindromeChecker::prevPalindrome(1901));
+}
+
+// Тест для проверки границ диапазона long long
+TEST_F(PalindromeTest, NextPrevSixtyFourBitLimits) {
+    EXPECT_EQ(9223372036302733229LL, PalindromeChecker::prevPalindrome(LLONG_MAX));
+    EXPECT_THROW(PalindromeChecker::nextPalindrome(LLONG_MAX), std::overflow_error);
+    EXPECT_EQ(9223372036302733229LL, PalindromeChecker::nearestPalindrome(LLONG_MAX));
     
-    void TearDown() override {
-        // Очистка после каждого теста
-    }
-};
+    EXPECT_EQ(-9223372036302733229LL, PalindromeChecker::nextPalindrome(LLONG_MIN));
+    EXPECT_THROW(PalindromeChecker::prevPalindrome(LLONG_MIN), std::overflow_error);
+    EXPECT_EQ(-9223372036302733229LL, PalindromeChecker::nearestPalindrome(LLONG_MIN));
+    
+    EXPECT_EQ(1000000000000000001LL, PalindromeChecker::nextPalindrome(999999999999999999LL + 1));
+    EXPECT_EQ(999999999999999999LL, PalindromeChecker::prevPalindrome(1000000000000000000LL));
+}
 
-// Тесты для строкового метода проверки палиндрома
+// Тест для проверки беззнаковых 64-битных чисел: они не сужаются до long long
+TEST_F(PalindromeTest, NextPrevUnsignedSixtyFourBit) {
+    unsigned long long tenToThe19 = 10000000000000000000ULL;
+    EXPECT_TRUE(static_cast<__int128>(tenToThe19) + 1 == PalindromeChecker::nextPalindrome(tenToThe19));
+    EXPECT_TRUE(static_cast<__int128>(tenToThe19) - 1 == PalindromeChecker::prevPalindrome(tenToThe19));
+    EXPECT_TRUE(PalindromeChecker::nextPalindrome(tenToThe19) > 0);
+    
+    // ULLONG_MAX = 18446744073709551615
+    __int128 below = static_cast<__int128>(1844674406604476448ULL) * 10 + 1;
+    __int128 above = static_cast<__int128>(1844674407704476448ULL) * 10 + 1;
+    EXPECT_TRUE(above == PalindromeChecker::nextPalindrome(ULLONG_MAX));
+    EXPECT_TRUE(below == PalindromeChecker::prevPalindrome(ULLONG_MAX));
+    EXPECT_TRUE(above == PalindromeChecker::nearestPalindrome(ULLONG_MAX));
+    
+    // Значения, помещающиеся в long long, дают тот же ответ, что и знаковая версия
+    unsigned long long limit = LLONG_MAX;
+    EXPECT_TRUE(PalindromeChecker::prevPalindrome(LLONG_MAX) == PalindromeChecker::prevPalindrome(limit));
+    EXPECT_TRUE(static_cast<__int128>(9223372037302733229ULL) == PalindromeChecker::nextPalindrome(limit));
+    EXPECT_EQ(1234321, PalindromeChecker::nextPalindrome(1234300u));
+}
 
-// Тест для проверки числа 0
-TEST_F(PalindromeTest, ZeroIsStringPalindrome) {
-    EXPECT_TRUE(PalindromeChecker::isPalindrome(0));
+// Тест для проверки 128-битной перегрузки
+TEST_F(PalindromeTest, NextPrevInt128) {
+    __int128 tenToThe30 = 1;
+    for (int i = 0; i < 30; ++i) {
+        tenToThe30 *= 10;
+    }
+    
+    // 10^30 -> 10^30 + 1 и 10^30 - 1
+    EXPECT_TRUE(tenToThe30 + 1 == PalindromeChecker::nextPalindrome(tenToThe30));
+    EXPECT_TRUE(tenToThe30 - 1 == PalindromeChecker::prevPalindrome(tenToThe30));
+    EXPECT_TRUE(tenToThe30 - 1 == PalindromeChecker::nearestPalindrome(tenToThe30));
+    EXPECT_TRUE(-(tenToThe30 + 1) == PalindromeChecker::prevPalindrome(-tenToThe30));
+    
+    __int128 maxValue = static_cast<__int128>(~static_cast<unsigned __int128>(0) >> 1);
+    EXPECT_THROW(PalindromeChecker::nextPalindrome(maxValue), std::overflow_error);
+    EXPECT_TRUE(PalindromeChecker::prevPalindrome(maxValue) < maxValue);
+    
+    // Совпадение с 64-битной версией на общих значениях
+    for (long long num : {0LL, 9LL, 10LL, 12345LL, 9223372036854775807LL}) {
+        EXPECT_TRUE(static_cast<__int128>(PalindromeChecker::prevPalindrome(num)) ==
+                    PalindromeChecker::prevPalindrome(static_cast<__int128>(num)));
+    }
 }
 
-// Тест для проверки однозначных чисел
-TEST_F(PalindromeTest, SingleDigitsAreStringPalindromes) {
-    for (int i = 1; i <= 9; ++i) {
-        EXPECT_TRUE(PalindromeChecker::isPalindrome(i)) << "Ошибка для числа " << i;
+// Тест для проверки пакетных версий
+TEST_F(PalindromeTest, PalindromeQueryBatch) {
+    long long numbers[] = {0, 10, 123, -130, 1234567890123LL};
+    long long next[5];
+    long long prev[5];
+    long long nearest[5];
+    
+    PalindromeChecker::nextPalindromeBatch(numbers, 5, next);
+    PalindromeChecker::prevPalindromeBatch(numbers, 5, prev);
+    PalindromeChecker::nearestPalindromeBatch(numbers, 5, nearest);
+    
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(PalindromeChecker::nextPalindrome(numbers[i]), next[i]);
+        EXPECT_EQ(PalindromeChecker::prevPalindrome(numbers[i]), prev[i]);
+        EXPECT_EQ(PalindromeChecker::nearestPalindrome(numbers[i]), nearest[i]);
+        EXPECT_TRUE(PalindromeChecker::isPalindrome(next[i]));
     }
 }
 
-// Тест для проверки двузначных палиндромов
-TEST_F(PalindromeTest, TwoDigitStringPalindromes) {
-    int palindromes[] = {11, 22, 33, 44, 55, 66, 77, 88, 99};
-    for (int num : palindromes) {
-        EXPECT_TRUE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+// Тест производительности пакетного поиска следующего палиндрома
+TEST_F(PalindromeTest, NextPalindromeBatchPerformance) {
+    const size_t SIZE = 1000000;
+    std::vector<long long> numbers(SIZE);
+    std::vector<long long> results(SIZE);
+    unsigned long long state = 88172645463325252ULL;
+    for (auto& number : numbers) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        number = static_cast<long long>(state % 9000000000000000000ULL);
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    PalindromeChecker::nextPalindromeBatch(numbers.data(), SIZE, results.data());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    
+    for (size_t i = 0; i < SIZE; i += 9973) {
+        EXPECT_TRUE(PalindromeChecker::isPalindromeNumeric(results[i]));
+        EXPECT_GE(results[i], numbers[i]);
     }
+    
+    std::cout << "Поиск следующего палиндрома для " << SIZE << " чисел: " << duration << " мс\n";
 }
 
-// Тест для проверки двузначных не-палиндромов
-TEST_F(PalindromeTest, TwoDigitStringNonPalindromes) {
-    int nonPalindromes[] = {10, 12, 23, 34, 45, 56, 67, 78, 89};
-    for (int num : nonPalindromes) {
-        EXPECT_FALSE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+// Тест для проверки табличного метода на последовательном диапазоне
+TEST_F(PalindromeTest, DigitTableMatchesStringMethod) {
+    for (long long num = -20000; num <= 200000; ++num) {
+        EXPECT_EQ(PalindromeChecker::isPalindrome(num), PalindromeChecker::isPalindromeDigitTable(num))
+            << "Ошибка для числа " << num;
     }
 }
 
-// Тест для проверки многозначных палиндромов
-TEST_F(PalindromeTest, MultiDigitStringPalindromes) {
-    long long palindromes[] = {121, 12321, 123321, 1234321, 12344321};
+// Тест для проверки табличного метода на палиндромах всех длин и крайних значениях
+TEST_F(PalindromeTest, DigitTableLargeNumbers) {
+    long long palindromes[] = {
+        1001, 10101, 1000000001LL, 12345678987654321LL, 123456789987654321LL,
+        1234567890987654321LL, 9223372036302733229LL, -9223372036302733229LL
+    };
     for (long long num : palindromes) {
-        EXPECT_TRUE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+        EXPECT_TRUE(PalindromeChecker::isPalindromeDigitTable(num)) << "Ошибка для числа " << num;
+    }
+    
+    long long nonPalindromes[] = {
+        1000000000000000000LL, 1234567890987654320LL, 1234567890997654321LL, LLONG_MAX, LLONG_MIN
+    };
+    for (long long num : nonPalindromes) {
+        EXPECT_FALSE(PalindromeChecker::isPalindromeDigitTable(num)) << "Ошибка для числа " << num;
     }
 }
 
-// Тест для проверки многозначных не-палиндромов
-TEST_F(PalindromeTest, MultiDigitStringNonPalindromes) {
-    long long nonPalindromes[] = {123, 1232, 12345, 123456, 1234567};
-    for (long long num : nonPalindromes) {
-        EXPECT_FALSE(PalindromeChecker::isPalindrome(num)) << "Ошибка для числа " << num;
+// Тест для проверки выбора метода через параметр шаблона
+TEST_F(PalindromeTest, MethodPolicies) {
+    for (long long num : {0LL, 7LL, 121LL, 123LL, 1221LL, -1221LL, 12345678987654321LL}) {
+        bool expected = PalindromeChecker::isPalindrome(num);
+        EXPECT_EQ(expected, PalindromeChecker::isPalindromeWith<PalindromeChecker::StringMethod>(num));
+        EXPECT_EQ(expected, PalindromeChecker::isPalindromeWith<PalindromeChecker::NumericMethod>(num));
+        EXPECT_EQ(expected, PalindromeChecker::isPalindromeWith<PalindromeChecker::DigitTableMethod>(num));
+        EXPECT_EQ(expected, PalindromeChecker::isPalindromeWith(num));
+    }
+}
+
+// Замер времени проверки массива чисел заданным методом
+template <typename Method>
+static long long measurePalindromeMethod(const std::vector<long long>& numbers, size_t& found) {
+    auto start = std::chrono::high_resolution_clock::now();
+    found = 0;
+    for (long long num : numbers) {
+        found += PalindromeChecker::isPalindromeWith<Method>(num) ? 1 : 0;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+// Тест производительности трех методов проверки
+TEST_F(PalindromeTest, MethodPerformance) {
+    const size_t SIZE = 1000000;
+    std::vector<long long> numbers;
+    numbers.reserve(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        // Половина чисел - 18-значные палиндромы, чтобы проверка не завершалась на первой цифре.
+        // 19-значные числа не берем: числовой метод на них может переполниться при развороте
+        long long num = PalindromeChecker::nextPalindrome(static_cast<long long>(i * 800000000000ULL + 100000000000000000ULL));
+        numbers.push_back(i % 2 == 0 ? num : num + 10);
+    }
+    
+    size_t foundString = 0;
+    size_t foundNumeric = 0;
+    size_t foundTable = 0;
+    auto stringDuration = measurePalindromeMethod<PalindromeChecker::StringMethod>(numbers, foundString);
+    auto numericDuration = measurePalindromeMethod<PalindromeChecker::NumericMethod>(numbers, foundNumeric);
+    auto tableDuration = measurePalindromeMethod<PalindromeChecker::DigitTableMethod>(numbers, foundTable);
+    
+    EXPECT_EQ(foundString, foundNumeric);
+    EXPECT_EQ(foundString, foundTable);
+    
+    std::cout << "Строковый метод, " << SIZE << " чисел: " << stringDuration << " мкс\n";
+    std::cout << "Числовой метод, " << SIZE << " чисел: " << numericDuration << " мкс\n";
+    std::cout << "Табличный метод, " << SIZE << " чисел: " << tableDuration << " мкс\n";
+}
+
+// Тест для проверки бюджета выделений памяти: числовые методы память не выделяют,
+// строковый создает не больше одной строки (короткие строки хранятся без выделения)
+TEST_F(PalindromeTest, AllocationBudget) {
+    std::vector<long long> numbers = {0, 7, 10, 121, -121, 1234321, 1234567, 123456789987654321LL,
+                                      1234567890987654321LL, 1234567890123456789LL};
+    for (long long number : numbers) {
+        bool expected = PalindromeChecker::isPalindromeDigitTable(number);
+        bool result = !expected;
+        EXPECT_LE(countAllocations([&] { result = PalindromeChecker::isPalindrome(number); }), 1u) << number;
+        EXPECT_EQ(expected, result) << number;
+
+        EXPECT_EQ(0u, countAllocations([&] {
+            (void)PalindromeChecker::isPalindromeDigitTable(number);
+            (void)PalindromeChecker::nearestPalindrome(number);
+        })) << number;
     }
-}
\ No newline at end of file
+    EXPECT_EQ(0u, countAllocations([] { (void)PalindromeChecker::isPalindromeNumeric(1234554321); }));
+}
+
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
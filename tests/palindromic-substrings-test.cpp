@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "palindromic_substrings.h"
+#include "allocation_counter.h"
+
+class PalindromicSubstringsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+    
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+    
+    static bool isPalindrome(const std::string& text, size_t offset, size_t length) {
+        for (size_t i = 0; i < length / 2; ++i) {
+            if (text[offset + i] != text[offset + length - 1 - i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Эталонный перебор всех подстрок длиной не больше maxLength
+    static unsigned long long bruteForceCount(const std::string& text, size_t maxLength) {
+        unsigned long long total = 0;
+        for (size_t start = 0; start < text.size(); ++start) {
+            for (size_t length = 1; length <= maxLength && start + length <= text.size(); ++length) {
+                total += isPalindrome(text, start, length) ? 1 : 0;
+            }
+        }
+        return total;
+    }
+    
+    static size_t bruteForceLongest(const std::string& text, size_t maxLength) {
+        size_t best = 0;
+        for (size_t start = 0; start < text.size(); ++start) {
+            for (size_t length = 1; length <= maxLength && start + length <= text.size(); ++length) {
+                if (length > best && isPalindrome(text, start, length)) {
+                    best = length;
+                }
+            }
+        }
+        return best;
+    }
+    
+    static std::string randomText(size_t size, unsigned int alphabet, unsigned int seed) {
+        std::string text(size, 'a');
+        for (auto& c : text) {
+            seed = seed * 1103515245u + 12345u;
+            c = static_cast<char>('a' + (seed >> 16) % alphabet);
+        }
+        return text;
+    }
+};
+
+// Тест для проверки пустой строки
+TEST_F(PalindromicSubstringsTest, EmptyText) {
+    PalindromicSubstrings finder;
+    
+    EXPECT_EQ(0, finder.longest("").length);
+    EXPECT_EQ(0, finder.count(""));
+}
+
+// Тест для проверки известных примеров
+TEST_F(PalindromicSubstringsTest, KnownExamples) {
+    PalindromicSubstrings finder;
+    
+    auto match = finder.longest("babad");
+    EXPECT_EQ(0, match.offset);
+    EXPECT_EQ(3, match.length);
+    
+    match = finder.longest("cbbd");
+    EXPECT_EQ(1, match.offset);
+    EXPECT_EQ(2, match.length);
+    
+    match = finder.longest("forgeeksskeegfor");
+    EXPECT_EQ(3, match.offset);
+    EXPECT_EQ(10, match.length);
+    
+    EXPECT_EQ(3, finder.count("abc"));
+    EXPECT_EQ(6, finder.count("aaa"));
+    EXPECT_EQ(1, finder.count("x"));
+}
+
+// Тест для проверки двоичных данных с нулевыми байтами
+TEST_F(PalindromicSubstringsTest, BinaryBuffer) {
+    PalindromicSubstrings finder;
+    const unsigned char data[] = {0, 1, 0, 0, 1, 0, 255};
+    
+    auto match = finder.longest(data, sizeof(data));
+    EXPECT_EQ(0, match.offset);
+    EXPECT_EQ(6, match.length);
+    EXPECT_EQ(12, finder.count(data, sizeof(data)));
+}
+
+// Тест для проверки совпадения с перебором на случайных строках
+TEST_F(PalindromicSubstringsTest, MatchesBruteForce) {
+    PalindromicSubstrings finder;
+    for (unsigned int seed = 1; seed <= 50; ++seed) {
+        std::string text = randomText(seed * 3, 2 + seed % 3, seed);
+        
+        auto match = finder.longest(text);
+        EXPECT_EQ(bruteForceLongest(text, text.size()), match.length) << text;
+        EXPECT_TRUE(isPalindrome(text, match.offset, match.length)) << text;
+        EXPECT_EQ(bruteForceCount(text, text.size()), finder.count(text)) << text;
+    }
+}
+
+// Тест для проверки потокового режима на границах окон
+TEST_F(PalindromicSubstringsTest, StreamingMatchesBruteForce) {
+    std::string path = ::testing::TempDir() + "palindromic_substrings.txt";
+    PalindromicSubstrings finder(7);
+    
+    for (unsigned int seed = 1; seed <= 20; ++seed) {
+        std::string text = randomText(40 + seed, 2, seed) + std::string(15, 'a');
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+        
+        for (size_t maxLength : {1u, 4u, 5u, 12u}) {
+            EXPECT_EQ(bruteForceCount(text, maxLength), finder.countInFile(path, maxLength));
+            
+            auto match = finder.longestInFile(path, maxLength);
+            EXPECT_EQ(bruteForceLongest(text, maxLength), match.length);
+            EXPECT_TRUE(isPalindrome(text, match.offset, match.length));
+        }
+    }
+    
+    EXPECT_THROW(finder.countInFile(path, 0), std::invalid_argument);
+    std::remove(path.c_str());
+    EXPECT_THROW(finder.countInFile(path, 10), std::runtime_error);
+}
+
+// Тест производительности на многомегабайтном тексте
+TEST_F(PalindromicSubstringsTest, Performance) {
+    const size_t SIZE = 8 << 20;
+    std::string text = randomText(SIZE, 4, 42);
+    text.replace(SIZE / 2, 9, "abcdedcba");
+    PalindromicSubstrings finder;
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    auto match = finder.longest(text);
+    auto count = finder.count(text);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    
+    EXPECT_GE(match.length, 9);
+    EXPECT_GT(count, SIZE);
+    
+    std::cout << "Поиск и подсчет палиндромов в " << SIZE << " байт: " << duration << " мс\n";
+}
+
+// Тест для проверки бюджета выделений памяти: буфер радиусов переиспользуется,
+// поэтому повторный поиск в тексте не длиннее прежнего память не выделяет
+TEST_F(PalindromicSubstringsTest, AllocationBudget) {
+    PalindromicSubstrings finder;
+    std::string text(10000, 'a');
+    for (size_t i = 0; i < text.size(); i += 7) {
+        text[i] = 'b';
+    }
+    (void)finder.longest(text);
+
+    PalindromeMatch match{0, 0};
+    unsigned long long total = 0;
+    EXPECT_EQ(0u, countAllocations([&] {
+        match = finder.longest(text);
+        total = finder.count(std::string_view(text).substr(0, 5000));
+    }));
+    EXPECT_GT(match.length, 0u);
+    EXPECT_GT(total, 5000u);
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
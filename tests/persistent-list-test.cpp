@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+#include "persistent_list.h"
+#include "linked_list.h"
+#include "allocation_counter.h"
+
+class PersistentListTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+    
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+    
+    // Количество различных узлов во всех версиях - реальный расход памяти на узлы
+    template <typename T>
+    static size_t countDistinctNodes(const std::vector<PersistentList<T>>& versions) {
+        std::unordered_set<const void*> nodes;
+        for (const auto& version : versions) {
+            for (auto current = version.getHead().get(); current; current = current->next.get()) {
+                nodes.insert(current);
+            }
+        }
+        return nodes.size();
+    }
+};
+
+// Тест для проверки пустого списка
+TEST_F(PersistentListTest, EmptyList) {
+    PersistentList<int> list;
+    
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(0, list.size());
+    EXPECT_EQ(nullptr, list.getHead());
+    EXPECT_THROW(static_cast<void>(list.front()), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(list.popFront()), std::out_of_range);
+}
+
+// Тест для проверки того, что pushFront не меняет исходную версию и разделяет хвост
+TEST_F(PersistentListTest, PushFrontSharesTail) {
+    PersistentList<int> base(std::vector<int>{2, 3});
+    auto extended = base.pushFront(1);
+    
+    EXPECT_EQ(std::vector<int>({2, 3}), base.toVector());
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), extended.toVector());
+    EXPECT_EQ(3, extended.size());
+    EXPECT_EQ(base.getHead(), extended.getHead()->next);
+}
+
+// Тест для проверки снимков: версии независимы друг от друга
+TEST_F(PersistentListTest, SnapshotsAreIndependent) {
+    PersistentList<int> list;
+    std::vector<PersistentList<int>> snapshots;
+    for (int i = 0; i < 5; ++i) {
+        list = list.pushFront(i);
+        snapshots.push_back(list);
+    }
+    
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(i + 1, snapshots[i].size());
+        EXPECT_EQ(i, snapshots[i].front());
+    }
+    EXPECT_EQ(5, countDistinctNodes(snapshots));
+}
+
+// Тест для проверки popFront
+TEST_F(PersistentListTest, PopFront) {
+    PersistentList<int> list(std::vector<int>{1, 2, 3});
+    auto tail = list.popFront();
+    
+    EXPECT_EQ(std::vector<int>({2, 3}), tail.toVector());
+    EXPECT_EQ(list.getHead()->next, tail.getHead());
+    EXPECT_EQ(3, list.size());
+}
+
+// Тест для проверки разворота
+TEST_F(PersistentListTest, Reverse) {
+    PersistentList<std::string> list(std::vector<std::string>{"Hello", "World", "C++"});
+    auto reversed = list.reverse();
+    
+    EXPECT_EQ(std::vector<std::string>({"C++", "World", "Hello"}), reversed.toVector());
+    EXPECT_EQ(std::vector<std::string>({"Hello", "World", "C++"}), list.toVector());
+    EXPECT_EQ(list.toVector(), reversed.reverse().toVector());
+}
+
+// Тест для проверки конкатенации: второй список разделяется целиком
+TEST_F(PersistentListTest, AppendSharesSecondList) {
+    PersistentList<int> first(std::vector<int>{1, 2});
+    PersistentList<int> second(std::vector<int>{3, 4, 5});
+    auto joined = first.append(second);
+    
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5}), joined.toVector());
+    EXPECT_EQ(5, joined.size());
+    EXPECT_EQ(second.getHead(), joined.getHead()->next->next);
+    EXPECT_EQ(std::vector<int>({1, 2}), first.toVector());
+    
+    EXPECT_EQ(second.getHead(), PersistentList<int>().append(second).getHead());
+    EXPECT_EQ(first.getHead(), first.append(PersistentList<int>()).getHead());
+}
+
+// Тест для проверки уничтожения длинного списка без переполнения стека
+TEST_F(PersistentListTest, LongListDestruction) {
+    PersistentList<int> list;
+    for (int i = 0; i < 1000000; ++i) {
+        list = list.pushFront(i);
+    }
+    auto snapshot = list.popFront().popFront();
+    list = PersistentList<int>();
+    
+    EXPECT_EQ(999998, snapshot.size());
+    EXPECT_EQ(999997, snapshot.front());
+}
+
+// Тест для проверки присваивания поверх длинного списка, которым больше никто не владеет
+TEST_F(PersistentListTest, LongListAssignment) {
+    const std::vector<int> values(2000000, 1);
+    const PersistentList<int> small(std::vector<int>{1, 2, 3});
+    
+    PersistentList<int> list(values);
+    list = PersistentList<int>();
+    EXPECT_TRUE(list.isEmpty());
+    
+    list = PersistentList<int>(values);
+    list = small;
+    EXPECT_EQ(small.toVector(), list.toVector());
+    
+    list = PersistentList<int>(values);
+    PersistentList<int> other = small;
+    list = std::move(other);
+    EXPECT_EQ(3u, list.size());
+    
+    list = list;
+    EXPECT_EQ(3u, list.size());
+}
+
+// Тест производительности и расхода памяти снимков в сравнении с копированием
+TEST_F(PersistentListTest, SnapshotPerformance) {
+    const int SIZE = 2000;
+    
+    // Персистентный список: снимок после каждой вставки
+    auto startPersistent = std::chrono::high_resolution_clock::now();
+    PersistentList<int> persistent;
+    std::vector<PersistentList<int>> versions;
+    versions.reserve(SIZE);
+    for (int i = 0; i < SIZE; ++i) {
+        persistent = persistent.pushFront(i);
+        versions.push_back(persistent);
+    }
+    auto endPersistent = std::chrono::high_resolution_clock::now();
+    auto durationPersistent = std::chrono::duration_cast<std::chrono::microseconds>(endPersistent - startPersistent).count();
+    
+    // Изменяемый список: снимок - глубокая копия конструктором копирования
+    auto startCopy = std::chrono::high_resolution_clock::now();
+    LinkedList<int> mutableList;
+    std::vector<LinkedList<int>> copies;
+    copies.reserve(SIZE);
+    size_t copiedNodes = 0;
+    for (int i = 0; i < SIZE; ++i) {
+        mutableList.pushFront(i);
+        copies.push_back(LinkedList<int>(mutableList));
+        copiedNodes += mutableList.size();
+    }
+    auto endCopy = std::chrono::high_resolution_clock::now();
+    auto durationCopy = std::chrono::duration_cast<std::chrono::microseconds>(endCopy - startCopy).count();
+    
+    size_t persistentNodes = countDistinctNodes(versions);
+    EXPECT_EQ(static_cast<size_t>(SIZE), persistentNodes);
+    EXPECT_LT(persistentNodes, copiedNodes);
+    
+    std::cout << "Снимки персистентного списка: " << durationPersistent << " мкс, узлов: "
+              << persistentNodes << " (" << persistentNodes * sizeof(PersistentList<int>::Node) << " байт)\n";
+    std::cout << "Снимки копированием: " << durationCopy << " мкс, узлов: "
+              << copiedNodes << " (" << copiedNodes * sizeof(LinkedList<int>::Node) << " байт)\n";
+}
+
+// Тест для проверки бюджета выделений памяти: новая версия с элементом в начале
+// выделяет один узел, удаление первого элемента память не выделяет
+TEST_F(PersistentListTest, AllocationBudget) {
+    PersistentList<int> list;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_LE(countAllocations([&] { list = list.pushFront(i); }), 1u);
+    }
+
+    PersistentList<int> tail;
+    EXPECT_EQ(0u, countAllocations([&] {
+        tail = list.popFront().popFront();
+    }));
+    EXPECT_EQ(97, tail.front());
+
+    PersistentList<int> reversed;
+    EXPECT_LE(countAllocations([&] { reversed = list.reverse(); }), list.size());
+    EXPECT_EQ(0, reversed.front());
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "pipeline.h"
+#include "pipeline_stages.h"
+
+class PipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки очереди без блокировок
+TEST_F(PipelineTest, SpscQueue) {
+    SpscQueue<int> queue(3);
+    int value = 0;
+
+    EXPECT_FALSE(queue.tryPop(value));
+    for (int i = 1; i <= 4; ++i) {
+        int item = i;
+        EXPECT_TRUE(queue.tryPush(item));
+    }
+    // Вместимость округлена до 4
+    int extra = 5;
+    EXPECT_FALSE(queue.tryPush(extra));
+
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+// Тест для составной задачи: палиндромные числа Фибоначчи в развернутом списке
+TEST_F(PipelineTest, FibonacciPalindromesReversed) {
+    std::vector<unsigned long long> expected;
+    for (unsigned long long value : FibonacciGenerator::generateFibonacci(94)) {
+        std::string digits = std::to_string(value);
+        if (std::equal(digits.begin(), digits.end(), digits.rbegin())) {
+            expected.insert(expected.begin(), value);
+        }
+    }
+
+    LinkedList<unsigned long long> list;
+    Pipeline pipeline(4, 2);
+    pipeline.source<unsigned long long>(PipelineStages::fibonacci(94))
+            .filter(PipelineStages::palindromes())
+            .forEach(PipelineStages::appendTo(list));
+    pipeline.wait();
+    list.reverse();
+
+    EXPECT_EQ(expected, list.toVector());
+}
+
+// Тест проверяет сохранение порядка при обратном давлении через маленькие очереди
+TEST_F(PipelineTest, OrderPreservedUnderBackPressure) {
+    const int count = 200000;
+    std::vector<long long> result;
+
+    Pipeline pipeline(7, 1);
+    pipeline.source<int>([count](Emitter<int>& emit) {
+                for (int i = 0; i < count; ++i) {
+                    emit(i);
+                }
+            })
+            .map([](int value) { return static_cast<long long>(value) * 3; })
+            .then<long long>([](long long value, Emitter<long long>& emit) {
+                emit(value);
+                emit(value + 1);
+            })
+            .forEach([&result](long long value) { result.push_back(value); });
+    pipeline.wait();
+
+    ASSERT_EQ(2u * count, result.size());
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(3LL * i, result[2 * i]);
+        EXPECT_EQ(3LL * i + 1, result[2 * i + 1]);
+    }
+}
+
+// Тест проверяет, что исключение стадии отменяет конвейер и пробрасывается из wait
+TEST_F(PipelineTest, ExceptionCancelsPipeline) {
+    Pipeline pipeline(16, 2);
+    int produced = 0;
+    pipeline.source<int>([&produced](Emitter<int>& emit) {
+                // Бесконечный источник останавливается по отмене
+                while (emit(produced)) {
+                    ++produced;
+                }
+            })
+            .filter([](int value) {
+                if (value == 1000) {
+                    throw std::runtime_error("Ошибка в стадии");
+                }
+                return true;
+            })
+            .forEach([](int) {});
+
+    EXPECT_THROW(pipeline.wait(), std::runtime_error);
+    EXPECT_GE(produced, 1000);
+}
+
+// Тест проверяет ошибки источника и повторное подключение выхода
+TEST_F(PipelineTest, SourceErrorsAndDoubleConnect) {
+    Pipeline overflow;
+    overflow.source<unsigned long long>(PipelineStages::fibonacci(95)).forEach([](unsigned long long) {});
+    EXPECT_THROW(overflow.wait(), std::overflow_error);
+
+    Pipeline pipeline;
+    auto stream = pipeline.source<int>([](Emitter<int>& emit) { emit(1); });
+    stream.forEach([](int) {});
+    EXPECT_THROW(stream.forEach([](int) {}), std::logic_error);
+    pipeline.wait();
+}
+
+// Тест проверяет, что выход без следующей стадии не вешает wait
+TEST_F(PipelineTest, UnconnectedOutput) {
+    Pipeline pipeline(8, 1);
+    pipeline.source<int>([](Emitter<int>& emit) {
+                for (int i = 0; emit(i); ++i) {
+                }
+            })
+            .map([](int value) { return value * 2; });
+    EXPECT_THROW(pipeline.wait(), std::logic_error);
+
+    Pipeline sourceOnly;
+    sourceOnly.source<int>([](Emitter<int>& emit) { emit(1); });
+    EXPECT_THROW(sourceOnly.wait(), std::logic_error);
+}
+
+// Тест проверяет добавление большого потока в непустой список с индексом
+TEST_F(PipelineTest, AppendToLongList) {
+    const int count = 200000;
+    LinkedList<int> list(std::vector<int>{-3, -2, -1});
+    list.enableIndex();
+
+    Pipeline pipeline;
+    pipeline.source<int>([count](Emitter<int>& emit) {
+                for (int i = 0; i < count; ++i) {
+                    emit(i);
+                }
+            })
+            .forEach(PipelineStages::appendTo(list, 1000));
+    pipeline.wait();
+
+    ASSERT_EQ(static_cast<size_t>(count) + 3, list.size());
+    EXPECT_EQ(-3, list.at(0));
+    for (int i = 0; i < count; i += 997) {
+        ASSERT_EQ(i, list.at(i + 3));
+    }
+    EXPECT_EQ(count - 1, list.at(count + 2));
+    list.pushBack(count);
+    EXPECT_EQ(count, list.toVector().back());
+}
+
+// Тест проверяет, что конвейер без wait завершается в деструкторе
+TEST_F(PipelineTest, DestructorCancels) {
+    auto pipeline = std::make_unique<Pipeline>(8, 1);
+    pipeline->source<int>([](Emitter<int>& emit) {
+        for (int i = 0; emit(i); ++i) {
+        }
+    }).forEach([](int) {});
+
+    pipeline.reset();
+    SUCCEED();
+}
+
+// Тест производительности конвейера из трех стадий
+TEST_F(PipelineTest, Performance) {
+    const int count = 10000000;
+
+    auto startSequential = std::chrono::high_resolution_clock::now();
+    long long sequentialSum = 0;
+    for (int i = 0; i < count; ++i) {
+        if (PalindromeChecker::isPalindromeWith<>(i)) {
+            sequentialSum += i;
+        }
+    }
+    auto endSequential = std::chrono::high_resolution_clock::now();
+
+    auto startPipeline = std::chrono::high_resolution_clock::now();
+    long long pipelineSum = 0;
+    Pipeline pipeline;
+    pipeline.source<int>([count](Emitter<int>& emit) {
+                for (int i = 0; i < count; ++i) {
+                    emit(i);
+                }
+            })
+            .filter([](int value) { return PalindromeChecker::isPalindromeWith<>(value); })
+            .forEach([&pipelineSum](int value) { pipelineSum += value; });
+    pipeline.wait();
+    auto endPipeline = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(sequentialSum, pipelineSum);
+
+    auto durationSequential = std::chrono::duration_cast<std::chrono::milliseconds>(endSequential - startSequential).count();
+    auto durationPipeline = std::chrono::duration_cast<std::chrono::milliseconds>(endPipeline - startPipeline).count();
+    std::cout << count << " чисел: последовательно " << durationSequential << " мс, конвейер из трех стадий "
+              << durationPipeline << " мс (потоков оборудования: " << std::thread::hardware_concurrency() << ")"
+              << std::endl;
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "rcu_list.h"
+#include "linked_list.h"
+
+class RcuListTest : public ::testing::Test {
+protected:
+    static std::vector<int> makeValues(int size) {
+        std::vector<int> values(size);
+        for (int i = 0; i < size; ++i) {
+            values[i] = i;
+        }
+        return values;
+    }
+
+    void SetUp() override {
+        // Настройка перед каждым тестом
+    }
+
+    void TearDown() override {
+        // Очистка после каждого теста
+    }
+};
+
+// Тест для проверки изменений и чтения в одном потоке
+TEST_F(RcuListTest, BasicOperations) {
+    RcuList<int> list(makeValues(5));
+    auto reader = list.reader();
+
+    std::vector<int> seen;
+    EXPECT_EQ(5u, reader.forEach([&seen](int value) { seen.push_back(value); }));
+    EXPECT_EQ(makeValues(5), seen);
+
+    list.reverse();
+    list.pushFront(10);
+    EXPECT_EQ(std::vector<int>({10, 4, 3, 2, 1, 0}), reader.read([](const PersistentList<int>& version) {
+        return version.toVector();
+    }));
+
+    list.update([](const PersistentList<int>& version) { return version.popFront().popFront(); });
+    EXPECT_EQ(std::vector<int>({3, 2, 1, 0}), list.snapshot().toVector());
+    EXPECT_THROW(list.update([](const PersistentList<int>& version) {
+        return version.popFront().popFront().popFront().popFront().popFront();
+    }), std::out_of_range);
+    EXPECT_EQ(4u, list.snapshot().size());
+}
+
+// Тест для проверки отложенного освобождения прежних версий
+TEST_F(RcuListTest, EpochReclamation) {
+    RcuList<int> list(makeValues(100));
+    auto reader = list.reader();
+
+    reader.read([&list](const PersistentList<int>& version) {
+        // Писатель публикует новые версии, пока читатель обходит старую
+        list.reverse();
+        list.pushFront(-1);
+        EXPECT_EQ(2u, list.pendingReclamation());
+        EXPECT_EQ(makeValues(100), version.toVector());
+        return 0;
+    });
+
+    // Чтение закончено: прежние версии можно освободить
+    list.reclaim();
+    EXPECT_EQ(0u, list.pendingReclamation());
+
+    list.reverse();
+    EXPECT_EQ(0u, list.pendingReclamation());
+    EXPECT_EQ(101u, reader.forEach([](int) {}));
+}
+
+// Тест для проверки ограничения числа читателей
+TEST_F(RcuListTest, ReaderSlots) {
+    RcuList<int> list;
+    std::vector<RcuList<int>::Reader> readers;
+    for (size_t i = 0; i < RcuList<int>::kMaxReaders; ++i) {
+        readers.push_back(list.reader());
+    }
+    EXPECT_THROW((void)list.reader(), std::runtime_error);
+
+    // Уничтоженный читатель освобождает ячейку
+    readers.pop_back();
+    EXPECT_NO_THROW((void)list.reader());
+}
+
+// Тест для проверки согласованности версий при одновременном чтении и записи
+TEST_F(RcuListTest, ConcurrentReadersSeeConsistentVersions) {
+    const int SIZE = 1000;
+    const int READERS = 4;
+    // Каждый читатель должен сделать столько обходов, пока писатель меняет список
+    const long long TRAVERSALS = 5;
+    RcuList<int> list(makeValues(SIZE));
+    std::atomic<bool> writing(false);
+    std::atomic<bool> stop(false);
+    std::atomic<int> inconsistent(0);
+    std::vector<std::atomic<long long>> reads(READERS);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&, r] {
+            auto reader = list.reader();
+            while (!writing.load()) {
+                std::this_thread::yield();
+            }
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Каждая версия - перестановка 0..SIZE-1 по возрастанию или по убыванию
+                int previous = -1;
+                int direction = 0;
+                bool ok = true;
+                size_t count = reader.forEach([&](int value) {
+                    if (previous >= 0) {
+                        int step = value - previous;
+                        if (direction == 0) {
+                            direction = step;
+                        }
+                        ok = ok && (step == 1 || step == -1) && step == direction;
+                    }
+                    previous = value;
+                });
+                if (!ok || count != static_cast<size_t>(SIZE)) {
+                    inconsistent.fetch_add(1);
+                }
+                reads[r].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    auto readersDone = [&] {
+        for (const auto& count : reads) {
+            if (count.load() < TRAVERSALS) {
+                return false;
+            }
+        }
+        return true;
+    };
+    // Писатель работает, пока каждый читатель не обойдет список TRAVERSALS раз
+    writing.store(true);
+    for (int updates = 0; updates < 200 || !readersDone(); ++updates) {
+        list.reverse();
+        // Новая голова с тем же значением: прежний головной узел освобождается по эпохам
+        list.update([](const PersistentList<int>& version) {
+            return version.popFront().pushFront(version.front());
+        });
+        if (updates >= 200) {
+            std::this_thread::yield();
+        }
+    }
+    stop.store(true);
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, inconsistent.load());
+    list.reclaim();
+    EXPECT_EQ(0u, list.pendingReclamation());
+}
+
+// Тест масштабируемости чтения: RCU против списка под общим мьютексом
+TEST_F(RcuListTest, ReadScalability) {
+    const int SIZE = 1000;
+    const auto duration = std::chrono::milliseconds(30);
+    const auto values = makeValues(SIZE);
+
+    RcuList<int> rcu(values);
+    LinkedList<int> locked(values);
+    std::mutex mutex;
+
+    // Каждый режим: threads читателей обходят список, писатель раз в миллисекунду разворачивает его.
+    // Время считается от общего старта читателей до их остановки
+    auto run = [&](int threads, bool useRcu) {
+        std::atomic<bool> go(false);
+        std::atomic<bool> stop(false);
+        std::atomic<long long> traversals(0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < threads; ++t) {
+            readers.emplace_back([&] {
+                long long local = 0;
+                long long sum = 0;
+                auto reader = rcu.reader();
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (useRcu) {
+                        reader.forEach([&sum](int value) { sum += value; });
+                    } else {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        locked.forEach([&sum](int value) { sum += value; });
+                    }
+                    ++local;
+                }
+                EXPECT_EQ(local * (SIZE - 1) * SIZE / 2, sum);
+                traversals.fetch_add(local);
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        go.store(true);
+        while (std::chrono::steady_clock::now() - start < duration) {
+            if (useRcu) {
+                rcu.reverse();
+            } else {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.reverse();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stop.store(true);
+        auto end = std::chrono::steady_clock::now();
+        for (auto& thread : readers) {
+            thread.join();
+        }
+        double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        return static_cast<double>(traversals.load()) / milliseconds;
+    };
+
+    std::cout << "Обходов списка из " << SIZE << " элементов в мс (потоков оборудования: "
+              << std::thread::hardware_concurrency() << ")\n";
+    std::cout << "  потоков         RCU     мьютекс\n";
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        double rcuRate = run(threads, true);
+        double lockedRate = run(threads, false);
+        std::cout << std::setw(9) << threads << std::setw(12) << std::fixed << std::setprecision(1) << rcuRate
+                  << std::setw(12) << lockedRate << "\n";
+    }
+    rcu.reclaim();
+    EXPECT_EQ(0u, rcu.pendingReclamation());
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
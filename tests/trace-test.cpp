@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fibonacci.h"
+#include "linked_list.h"
+#include "palindrome.h"
+#include "trace.h"
+#include "allocation_counter.h"
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tracer::instance().disable();
+        Tracer::instance().clear();
+    }
+
+    void TearDown() override {
+        Tracer::instance().disable();
+        Tracer::instance().clear();
+    }
+
+    static size_t countOccurrences(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+    static std::string exportTrace() {
+        std::ostringstream out;
+        Tracer::instance().exportChromeTrace(out);
+        return out.str();
+    }
+};
+
+// Тест проверяет, что выключенная трассировка ничего не записывает
+TEST_F(TraceTest, DisabledRecordsNothing) {
+    FibonacciGenerator::generateFibonacci(10);
+    PalindromeChecker::isPalindrome(121);
+
+    std::string trace = exportTrace();
+    EXPECT_EQ(0u, countOccurrences(trace, "\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("\"traceEvents\""));
+}
+
+// Тест проверяет участки для инструментированных вызовов
+TEST_F(TraceTest, InstrumentedCalls) {
+    Tracer::instance().enable();
+
+    FibonacciGenerator::generateFibonacci(20);
+    PalindromeChecker::isPalindrome(12321);
+    PalindromeChecker::isPalindromeNumeric(12321);
+    LinkedList<int> list;
+    for (int i = 0; i < 5; ++i) {
+        list.pushBack(i);
+    }
+    list.reverse();
+    auto values = list.toVector();
+
+    std::string trace = exportTrace();
+    EXPECT_EQ(1u, countOccurrences(trace, "\"FibonacciGenerator::generateFibonacci\""));
+    EXPECT_EQ(1u, countOccurrences(trace, "\"PalindromeChecker::isPalindrome\""));
+    EXPECT_EQ(1u, countOccurrences(trace, "\"PalindromeChecker::isPalindromeNumeric\""));
+    EXPECT_EQ(5u, countOccurrences(trace, "\"LinkedList::pushBack\""));
+    EXPECT_EQ(1u, countOccurrences(trace, "\"LinkedList::reverse\""));
+    EXPECT_EQ(1u, countOccurrences(trace, "\"LinkedList::toVector\""));
+    EXPECT_EQ(std::vector<int>({4, 3, 2, 1, 0}), values);
+}
+
+// Тест проверяет вложенные участки и отдельные идентификаторы потоков
+TEST_F(TraceTest, NestedSpansAndThreads) {
+    Tracer::instance().enable();
+
+    {
+        TraceSpan outer("outer \"quoted\"");
+        TraceSpan inner("inner");
+    }
+    std::thread worker([] {
+        TraceSpan span("worker");
+    });
+    worker.join();
+
+    std::string trace = exportTrace();
+    EXPECT_NE(std::string::npos, trace.find("\"outer \\\"quoted\\\"\""));
+    EXPECT_NE(std::string::npos, trace.find("\"inner\""));
+
+    size_t mainThread = trace.find("\"tid\":", trace.find("\"inner\""));
+    size_t workerThread = trace.find("\"tid\":", trace.find("\"worker\""));
+    EXPECT_NE(trace.substr(mainThread, 8), trace.substr(workerThread, 8));
+}
+
+// Тест проверяет, что кольцевой буфер хранит только последние события
+TEST_F(TraceTest, RingBufferKeepsLatest) {
+    Tracer::instance().enable();
+
+    for (size_t i = 0; i < Tracer::kBufferCapacity + 100; ++i) {
+        TraceSpan span("span");
+    }
+
+    EXPECT_EQ(Tracer::kBufferCapacity, countOccurrences(exportTrace(), "\"span\""));
+}
+
+// Тест проверяет, что буферы завершившихся потоков используются повторно:
+// после экспорта сразу, без экспорта - сверх kMaxRetiredBuffers
+TEST_F(TraceTest, ThreadBuffersRecycled) {
+    Tracer::instance().enable();
+    auto runThread = [] {
+        std::thread worker([] {
+            TraceSpan span("short-lived");
+        });
+        worker.join();
+    };
+
+    runThread();
+    exportTrace();
+    size_t buffers = Tracer::instance().bufferCount();
+    for (int i = 0; i < 100; ++i) {
+        runThread();
+        EXPECT_EQ(1u, countOccurrences(exportTrace(), "\"short-lived\""));
+    }
+    EXPECT_EQ(buffers, Tracer::instance().bufferCount());
+
+    // Без экспорта события хранятся, пока завершившихся потоков не больше kMaxRetiredBuffers
+    for (size_t i = 0; i < 3 * Tracer::kMaxRetiredBuffers; ++i) {
+        runThread();
+    }
+    EXPECT_LE(Tracer::instance().bufferCount(), buffers + Tracer::kMaxRetiredBuffers + 1);
+    EXPECT_LE(Tracer::kMaxRetiredBuffers, countOccurrences(exportTrace(), "\"short-lived\""));
+}
+
+// Тест производительности: стоимость участка с включенной и выключенной трассировкой
+TEST_F(TraceTest, SpanOverhead) {
+    const int spans = 5000000;
+
+    auto measure = [spans] {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < spans; ++i) {
+            TraceSpan span("overhead");
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / spans;
+    };
+
+    double disabled = measure();
+    Tracer::instance().enable();
+    double enabled = measure();
+
+    std::cout << "Участок трассы: выключено " << disabled << " нс, включено " << enabled << " нс" << std::endl;
+    EXPECT_LT(disabled, 5.0);
+}
+
+// Тест для проверки бюджета выделений памяти: после регистрации буфера потока
+// участки трассы память не выделяют, ни включенные, ни выключенные
+TEST_F(TraceTest, AllocationBudget) {
+    Tracer::instance().enable();
+    { TraceSpan warmup("warmup"); }
+
+    EXPECT_EQ(0u, countAllocations([] {
+        for (int i = 0; i < 1000; ++i) {
+            TraceSpan span("enabled");
+        }
+    }));
+
+    Tracer::instance().disable();
+    EXPECT_EQ(0u, countAllocations([] {
+        for (int i = 0; i < 1000; ++i) {
+            TraceSpan span("disabled");
+        }
+    }));
+}
+
+// Функция main является необязательной, если вы используете gtest_main
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}